@@ -0,0 +1,300 @@
+/*
+	Yong Wen Chua
+	http://bit.ly/yongwen
+	Released under the LGPL license
+*/
+/*
+	Benchmark times the operations of the list containers on lists of 10^3 to 10^7 ListNodeData records.
+
+	Usage: Benchmark [--min N] [--max N] [--only CONTAINER] [--json FILE]
+		--min, --max	Smallest and largest list size. Sizes go up by a factor of 10. By default, 1000 to 1000000
+		--only			Only time one container: linked, unrolled, doubly or columnar
+		--json			Also write the results to FILE as JSON
+
+	Each result is reported in ns/op and ops/sec. What an op is depends on the benchmark:
+		- sort_random, sort_sorted, sort_reversed, sort_nearly, reverse, read_data_file, dump_file: one record
+		- insert_ordered, delete_text, delete_number, search, length: one call
+	Calls whose cost grows with the list are timed fewer times on longer lists, so that every size finishes quickly.
+	read_data_file and dump_file are timed on DataList, the container the program is built with (see Operation.h).
+*/
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <fstream>
+#include <iostream>
+#include <algorithm>
+#include <type_traits>
+#include "Operation.h"
+#include "OutputWriter.h"
+#include "KeyKernels.h"
+using namespace std;
+
+//Global Variables used by Operation.cpp
+DataList  TheList;
+ifstream CommandFile;
+OutputWriter OutputFile;
+string FileNumber;
+
+//Used by Operation.cpp on fatal errors. Unlike the program's, it does not wait for the user
+void TerminateError(string message){
+	OutputFile.Close();
+	cerr << "Error encountered: " << message << endl;
+	exit(1);
+}
+
+//The containers timed
+typedef DoublyLinkedList<ListNodeData, SlabNodeAllocator<DoublyListNode<ListNodeData> >, HashIndex<ListNodeData, DataKey, DataKeyOf>, ListAggregates<ListNodeData> > DoublyDataList;
+typedef UnrolledLinkedList<ListNodeData, 16> UnrolledDataList;
+
+//What each container supports beyond the operations they all have
+template <typename TList> struct Supports{
+	static const bool Index = false;		//EnableIndex()
+	static const bool Search = true;		//SearchForNode()
+};
+template <> struct Supports<DataShard>{
+	static const bool Index = true;
+	static const bool Search = true;
+};
+template <> struct Supports<ColumnarList>{
+	static const bool Index = false;
+	static const bool Search = false;
+};
+
+struct Result{
+	string Container, Benchmark;
+	int Size;
+	long long Ops;
+	double Seconds;
+};
+static vector<Result> Results;
+
+static void Report(const string &container, const string &benchmark, int size, long long ops, double seconds){
+	Result result = { container, benchmark, size, ops, seconds };
+	Results.push_back(result);
+	double perOp = seconds * 1e9 / (double) ops;
+	printf("%-10s %-16s %9d %14.1f ns/op %16.0f ops/sec\n", container.c_str(), benchmark.c_str(), size, perOp, (seconds > 0) ? ops / seconds : 0.0);
+	fflush(stdout);
+}
+
+template <typename TFunction> static double Time(TFunction function){
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	function();
+	return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+//Number of times to time a call whose cost grows with the list
+static int CallsFor(int size){
+	long long calls = 100000000LL / size;
+	return (int) max(10LL, min(10000LL, calls));
+}
+
+static unsigned int Seed = 12345;
+static unsigned int Random(){
+	Seed = Seed * 1103515245 + 12345;
+	return Seed >> 8;
+}
+
+//Records with random numbers. Every text is shared by about two records
+static vector<ListNodeData> MakeRecords(int size){
+	vector<ListNodeData> records;
+	records.reserve(size);
+	for (int i = 0; i < size; i++){
+		records.push_back(ListNodeData((int) (Random() % (unsigned int) (size * 4)), "name" + to_string(Random() % (unsigned int) (size / 2 + 1))));
+	}
+	return records;
+}
+
+template <typename TList> static void Fill(TList &list, const vector<ListNodeData> &records){
+	for (size_t i = 0; i < records.size(); i++){
+		list.PushBack(records[i]);
+	}
+}
+
+template <typename TList> static void EnableIndex(TList &, false_type){}
+template <typename TList> static void EnableIndex(TList &list, true_type){
+	list.EnableIndex();
+}
+
+template <typename TList> static void TimeSearch(const string &, TList &, int, const vector<ListNodeData> &, false_type){}
+template <typename TList> static void TimeSearch(const string &name, TList &list, int size, const vector<ListNodeData> &records, true_type){
+	int calls = CallsFor(size);
+	long long found = 0;
+	double seconds = Time([&]{
+		for (int i = 0; i < calls; i++){
+			list.Rewind();
+			found += (list.SearchForNode(records[Random() % records.size()].Text()) != NULL) ? 1 : 0;
+		}
+	});
+	Report(name, "search", size, calls, seconds);
+}
+
+template <typename TList> static void TimeContainer(const string &name, int size){
+	vector<ListNodeData> records = MakeRecords(size);
+
+	//Sorts of differently ordered input
+	vector<ListNodeData> sorted = records;
+	stable_sort(sorted.begin(), sorted.end());
+	vector<ListNodeData> reversed(sorted.rbegin(), sorted.rend());
+	vector<ListNodeData> nearly = sorted;
+	for (int i = 0; i < size / 100 + 1; i++){		//Swap 1% of the records out of place
+		swap(nearly[Random() % size], nearly[Random() % size]);
+	}
+	const vector<ListNodeData> *inputs[] = { &records, &sorted, &reversed, &nearly };
+	const char *names[] = { "sort_random", "sort_sorted", "sort_reversed", "sort_nearly" };
+	for (int i = 0; i < 4; i++){
+		TList list;
+		Fill(list, *inputs[i]);
+		Report(name, names[i], size, size, Time([&]{ list.Sort(Ascending); }));
+	}
+
+	//The rest work on a sorted list
+	TList list;
+	EnableIndex(list, integral_constant<bool, Supports<TList>::Index>());
+	Fill(list, records);
+	list.Sort(Ascending);
+
+	Report(name, "reverse", size, 2LL * size, Time([&]{ list.Reverse(); list.Reverse(); }));
+
+	const int lengthCalls = 1000000;
+	volatile long long total = 0;
+	Report(name, "length", size, lengthCalls, Time([&]{
+		for (int i = 0; i < lengthCalls; i++){
+			total += list.Length();
+		}
+	}));
+
+	int calls = CallsFor(size);
+	vector<ListNodeData> inserts = MakeRecords(calls);
+	Report(name, "insert_ordered", size, calls, Time([&]{
+		for (int i = 0; i < calls; i++){
+			list.InsertNewNodeOrdered(inserts[i]);
+		}
+	}));
+
+	TimeSearch(name, list, size, records, integral_constant<bool, Supports<TList>::Search>());
+
+	Report(name, "delete_text", size, calls, Time([&]{
+		for (int i = 0; i < calls; i++){
+			list.DeleteNode(records[Random() % records.size()].Text(), 1);
+		}
+	}));
+	Report(name, "delete_number", size, calls, Time([&]{
+		for (int i = 0; i < calls; i++){
+			list.DeleteNode(records[Random() % records.size()].Number(), 1);
+		}
+	}));
+}
+
+//Reads and dumps a data file of size records through Operation.cpp
+static void TimeFiles(const string &name, int size){
+	const char *data = "data_bench.txt", *output = "output_bench.txt";
+	{
+		vector<ListNodeData> records = MakeRecords(size);
+		OutputWriter file;
+		remove(data);
+		if (!file.Open(data)){
+			TerminateError("Unable to write data file.");
+		}
+		for (size_t i = 0; i < records.size(); i++){
+			file << records[i].Text() << '\n' << records[i].Number() << '\n';
+		}
+	}
+	FileNumber = "bench";
+	TheList.Clear();		//Each size is read into an empty list
+	ostringstream quiet;		//Operation.cpp reports what it does on cout
+	streambuf *console = cout.rdbuf(quiet.rdbuf());
+	double read = Time([]{ ReadDataFile(); });
+	remove(output);
+	double dump = Time([]{ DumpFile(); OutputFile.Close(); });
+	cout.rdbuf(console);
+	Report(name, "read_data_file", size, size, read);
+	Report(name, "dump_file", size, size, dump);
+	remove(data);
+	remove(output);
+}
+
+static void WriteJson(const char *path){
+	ofstream json(path);
+	if (!json){
+		TerminateError("Unable to write JSON file.");
+	}
+	const char *kernels[] = { "plain", "sse4.1", "avx2" };
+	json << "{\n  \"kernels\": \"" << kernels[KeyKernelsInUse()] << "\",\n  \"results\": [\n";
+	for (size_t i = 0; i < Results.size(); i++){
+		const Result &result = Results[i];
+		double perOp = result.Seconds * 1e9 / (double) result.Ops;
+		json << "    {\"container\": \"" << result.Container << "\", \"benchmark\": \"" << result.Benchmark
+			<< "\", \"size\": " << result.Size << ", \"ops\": " << result.Ops << ", \"seconds\": " << result.Seconds
+			<< ", \"ns_per_op\": " << perOp << ", \"ops_per_sec\": " << ((result.Seconds > 0) ? result.Ops / result.Seconds : 0.0)
+			<< "}" << (i + 1 < Results.size() ? "," : "") << "\n";
+	}
+	json << "  ]\n}\n";
+}
+
+int main(int argc, char* argv[]){
+	int minSize = 1000, maxSize = 1000000;
+	string only;
+	const char *json = NULL;
+	for (int i = 1; i < argc; i++){
+		string option = argv[i];
+		if (i + 1 >= argc){
+			TerminateError("Missing value for " + option);
+		}
+		if (option == "--min"){
+			minSize = atoi(argv[++i]);
+		}
+		else if (option == "--max"){
+			maxSize = atoi(argv[++i]);
+		}
+		else if (option == "--only"){
+			only = argv[++i];
+		}
+		else if (option == "--json"){
+			json = argv[++i];
+		}
+		else{
+			TerminateError("Unknown option " + option);
+		}
+	}
+	if (minSize < 1){
+		TerminateError("--min has to be at least 1.");
+	}
+
+	#if defined(USE_UNROLLED_LIST)
+		const char *dataList = "unrolled";
+	#elif defined(USE_SHARDED_LIST)
+		const char *dataList = "sharded";
+	#elif defined(USE_DOUBLY_LINKED_LIST)
+		const char *dataList = "doubly";
+	#elif defined(USE_COLUMNAR_LIST)
+		const char *dataList = "columnar";
+	#else
+		const char *dataList = "linked";
+	#endif
+	for (long long size = minSize; size <= maxSize; size *= 10){
+		int n = (int) size;
+		if (only.empty() || only == "linked"){
+			TimeContainer<DataShard>("linked", n);
+		}
+		if (only.empty() || only == "unrolled"){
+			TimeContainer<UnrolledDataList>("unrolled", n);
+		}
+		if (only.empty() || only == "doubly"){
+			TimeContainer<DoublyDataList>("doubly", n);
+		}
+		if (only.empty() || only == "columnar"){
+			TimeContainer<ColumnarList>("columnar", n);
+		}
+		if (only.empty() || only == dataList){
+			TimeFiles(dataList, n);
+		}
+	}
+	if (json != NULL){
+		WriteJson(json);
+	}
+	return 0;
+}
@@ -0,0 +1,275 @@
+/*
+	Yong Wen Chua
+	http://bit.ly/yongwen
+	Released under the LGPL license
+*/
+/*
+	ColumnarList stores ListNodeData records column by column. See ColumnarList.h
+*/
+#include "ColumnarList.h"
+#include "KeyKernels.h"
+#include <algorithm>
+#include <deque>
+#include <unordered_map>
+using namespace std;
+
+ColumnarList::ColumnarList(){
+	_record._list = this;
+	_record._row = 0;
+	_SortStatus = Unordered;
+	Rewind();
+}
+
+/*
+	Retrieving Methods. These only read the number column, with the kernels in KeyKernels.h
+*/
+long long ColumnarList::Sum(){
+	return KeySum(_numbers.data(), _numbers.size());
+}
+
+int ColumnarList::Min(){
+	return KeyMin(_numbers.data(), _numbers.size());
+}
+
+int ColumnarList::Max(){
+	return KeyMax(_numbers.data(), _numbers.size());
+}
+
+int ColumnarList::CountInRange(int low, int high){
+	return (int) KeyCountInRange(_numbers.data(), _numbers.size(), low, high);
+}
+
+/*
+	Iteration Methods
+*/
+ColumnarList::Record *ColumnarList::Current(){
+	if (_current >= (int) _order.size()){
+		return NULL;
+	}
+	_record._row = _order[_current];
+	return &_record;
+}
+
+ColumnarList::Record *ColumnarList::Next(){
+	if (_current < (int) _order.size()){
+		_current++;
+	}
+	return Current();
+}
+
+/*
+	Helper Methods
+*/
+int ColumnarList::_AddRow(int number, string text){
+	_numbers.push_back(number);
+	_texts.push_back(std::move(text));
+	return (int) _numbers.size() - 1;
+}
+
+//Unordered lists take each new record at the head, so the new rows go to the front in reverse. Otherwise, as in
+//LinkedList::InsertOrderedBatch(), the new rows are reversed and sorted stably, then merged into the order. On ties, a new
+//row goes before the rows already there.
+void ColumnarList::_OrderNewRows(int first){
+	vector<int> rows;
+	for (int row = (int) _numbers.size() - 1; row >= first; row--){
+		rows.push_back(row);
+	}
+	if (_SortStatus == Unordered){
+		_order.insert(_order.begin(), rows.begin(), rows.end());
+		return;
+	}
+	stable_sort(rows.begin(), rows.end(), [this](int a, int b){ return _Before(a, b); });
+	vector<int> order;
+	order.reserve(_order.size() + rows.size());
+	merge(rows.begin(), rows.end(), _order.begin(), _order.end(), back_inserter(order), [this](int a, int b){ return _Before(a, b); });
+	_order.swap(order);
+}
+
+//Rows after a deleted row move down to fill the gap, keeping their relative order
+void ColumnarList::_RemoveRows(const vector<bool> &removed){
+	vector<int> moved(_numbers.size());		//New index of each row that is kept
+	int kept = 0;
+	for (size_t row = 0; row < _numbers.size(); row++){
+		if (removed[row]){
+			continue;
+		}
+		if ((int) row != kept){
+			_numbers[kept] = _numbers[row];
+			_texts[kept] = std::move(_texts[row]);
+		}
+		moved[row] = kept++;
+	}
+	_numbers.resize(kept);
+	_texts.resize(kept);
+	size_t position = 0;
+	for (size_t i = 0; i < _order.size(); i++){
+		if (!removed[_order[i]]){
+			_order[position++] = moved[_order[i]];
+		}
+	}
+	_order.resize(position);
+	Rewind();
+}
+
+/*
+	Modifying Methods
+*/
+void ColumnarList::PushBack(const ListNodeData &data){
+	EmplaceBack(data.Number(), data.Text());
+}
+
+void ColumnarList::EmplaceBack(int number, const char *text, size_t length){
+	_order.push_back(_AddRow(number, string(text, length)));
+	_SortStatus = Unordered;
+}
+
+void ColumnarList::EmplaceBack(int number, const string &text){
+	_order.push_back(_AddRow(number, text));
+	_SortStatus = Unordered;
+}
+
+//The order is sorted, so the place of the new record is found by a binary search
+void ColumnarList::InsertNewNodeOrdered(const ListNodeData &data){
+	int row = _AddRow(data.Number(), data.Text());
+	if (_SortStatus == Unordered){
+		_order.insert(_order.begin(), row);
+		return;
+	}
+	vector<int>::iterator position = partition_point(_order.begin(), _order.end(), [this, row](int other){ return _Before(other, row); });
+	_order.insert(position, row);
+}
+
+int ColumnarList::DeleteNode(const string &search, int n){
+	vector<bool> removed(_numbers.size(), false);
+	int count = 0;
+	for (size_t i = 0; i < _order.size() && (n > 0 || n == -1); i++){
+		if (_texts[_order[i]] == search){
+			removed[_order[i]] = true;
+			count++;
+			if (n != -1){			//-1 is to delete ALL items that match
+				n--;
+			}
+		}
+	}
+	if (count > 0){
+		_RemoveRows(removed);
+	}
+	Rewind();
+	return count;
+}
+
+//The number column is scanned for the matching rows. Only if not all of them are to be deleted does the order matter,
+//in which case the list is walked to find the first n of them
+int ColumnarList::DeleteNode(int number, int n){
+	const int *numbers = _numbers.data();
+	size_t rows = _numbers.size(), row = KeyFind(numbers, rows, number);
+	if (row == rows || n == 0){
+		Rewind();
+		return 0;
+	}
+	vector<bool> removed(rows, false);
+	int count = 0;
+	if (n == -1){
+		while (row < rows){
+			removed[row] = true;
+			count++;
+			row += 1 + KeyFind(numbers + row + 1, rows - row - 1, number);
+		}
+	}
+	else{
+		for (size_t i = 0; i < _order.size() && count < n; i++){
+			if (numbers[_order[i]] == number){
+				removed[_order[i]] = true;
+				count++;
+			}
+		}
+	}
+	_RemoveRows(removed);
+	return count;
+}
+
+void ColumnarList::Clear(){
+	_numbers.clear();
+	_texts.clear();
+	_order.clear();
+	_SortStatus = Unordered;
+	Rewind();
+}
+
+//As in LinkedList::DeleteNodesBatch(), the list is walked once and the text of each record is looked up among the keys
+int ColumnarList::DeleteNodesBatch(const vector<string> &keys, const vector<int> &counts, vector<int> &deleted){
+	int total = 0;
+	deleted.assign(keys.size(), 0);
+	//The requests still to be satisfied for each key, in the order they were given
+	unordered_map<string, deque<size_t> > wanted;
+	for (size_t i = 0; i < keys.size(); i++){
+		if (counts[i] != 0){
+			wanted[keys[i]].push_back(i);
+		}
+	}
+	vector<bool> removed(_numbers.size(), false);
+	for (size_t i = 0; i < _order.size() && !wanted.empty(); i++){
+		unordered_map<string, deque<size_t> >::iterator found = wanted.find(_texts[_order[i]]);
+		if (found == wanted.end()){
+			continue;
+		}
+		size_t request = found -> second.front();
+		if (++deleted[request] == counts[request]){		//Satisfied. A count of -1 never is
+			found -> second.pop_front();
+			if (found -> second.empty()){
+				wanted.erase(found);
+			}
+		}
+		removed[_order[i]] = true;
+		total++;
+	}
+	if (total > 0){
+		_RemoveRows(removed);
+	}
+	Rewind();
+	return total;
+}
+
+/*
+	Sort Related
+*/
+void ColumnarList::Reverse(){
+	if (_order.size() < 2){
+		return;
+	}
+	reverse(_order.begin(), _order.end());
+	Rewind();
+	switch (_SortStatus){
+		case Ascending:
+			_SortStatus = Descending;
+			break;
+		case Descending:
+			_SortStatus = Ascending;
+			break;
+		default:
+			_SortStatus = Unordered;
+			break;
+	}
+}
+
+void ColumnarList::Sort(SortOrder SortBy){
+	if (SortBy == Unordered){
+		return;
+	}
+	if (_order.size() < 2){
+		return;
+	}
+	_SortStatus = SortBy;
+	stable_sort(_order.begin(), _order.end(), [this](int a, int b){ return _Before(a, b); });
+	//Lay the rows out in list order
+	vector<int> numbers(_order.size());
+	vector<string> texts(_order.size());
+	for (size_t i = 0; i < _order.size(); i++){
+		numbers[i] = _numbers[_order[i]];
+		texts[i] = std::move(_texts[_order[i]]);
+		_order[i] = (int) i;
+	}
+	_numbers.swap(numbers);
+	_texts.swap(texts);
+	Rewind();
+}
@@ -0,0 +1,126 @@
+/*
+	Yong Wen Chua
+	http://bit.ly/yongwen
+	Released under the LGPL license
+*/
+/*
+	ColumnarList is a list of ListNodeData records stored column by column instead of node by node.
+
+	The numbers of all records are kept in one contiguous int array, and their texts in a separate array of strings.
+	A record is a row: the same index into both columns. The order of the list is a third array, holding the rows in
+	list order. Sum(), Min(), Max() and searches by number only read the number column, so they run over dense memory
+	and never touch the texts. They use the vector kernels in KeyKernels.h.
+	Rows are kept packed: deleting records closes the gaps in the columns.
+
+	It offers the operations of LinkedList that the program uses, and behaves like them. Current() returns a Record,
+	which is used like a node: Current() -> Data().Text(). A Record stays valid until the list is next modified.
+	Inserting or deleting a record in the middle of the list moves the entries of the order array after it, which are
+	ints, and nothing else.
+*/
+//These Macros ensure that the file is only #included once.
+#pragma once
+#ifndef ColumnarList_H
+#define ColumnarList_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <utility>
+#include "ListNodeData.h"
+#include "SortPolicies.h"
+
+class ColumnarList{
+	public:
+		//The current record. See Current()
+		class Record{
+			friend class ColumnarList;
+			ColumnarList *_list;
+			int _row;
+			public:
+				Record &Data(){ return *this; }		//So that a Record is used like a node
+				int Number() const { return _list -> _numbers[_row]; }
+				const std::string &Text() const { return _list -> _texts[_row]; }
+		};
+
+	private:
+		std::vector<int> _numbers;			//Number column
+		std::vector<std::string> _texts;	//Text column
+		std::vector<int> _order;			//Rows in list order
+		int _current;						//Position in _order of the current record
+		Record _record;
+
+		//Adds a row to the columns and returns it. The row is not in the order yet
+		int _AddRow(int number, std::string text);
+		//Puts the rows from first onwards, which were just added, into the order as InsertNewNodeOrdered() would one by one
+		void _OrderNewRows(int first);
+		//Returns true if row a goes strictly before row b in SortStatus order
+		bool _Before(int a, int b) const {
+			return (_SortStatus == Ascending) ? (_numbers[a] < _numbers[b]) : (_numbers[a] > _numbers[b]);
+		}
+		//Deletes the rows marked in removed and packs the columns
+		void _RemoveRows(const std::vector<bool> &removed);
+
+		//Records returned by Current() point into the list, so it cannot be copied
+		ColumnarList(const ColumnarList &);
+		ColumnarList &operator=(const ColumnarList &);
+
+	public:
+		ColumnarList();
+
+		/*
+			Retrieving Methods
+		*/
+		int Length(){ return (int) _order.size(); }
+		long long Sum();	//Sum of the numbers
+		int Min();			//Minimum of the numbers. 0 if the list is empty
+		int Max();			//Maximum of the numbers. 0 if the list is empty
+		int CountInRange(int low, int high);		//Number of records whose number is from low to high, inclusive
+
+		/*
+			Iteration Methods. These behave like the ones in LinkedList
+		*/
+		void Rewind(){ _current = 0; }
+		Record *Current();
+		Record *Next();
+
+		/*
+			Modifying Methods. These behave like the ones in LinkedList
+		*/
+		void PushBack(const ListNodeData &data);		//Append at the end of the list. Sets SortStatus to Unordered
+		void EmplaceBack(int number, const char *text, size_t length);
+		void EmplaceBack(int number, const std::string &text);
+		void InsertNewNodeOrdered(const ListNodeData &data);		//Insert in the order determined by SortStatus
+		//Insert the records in [first, last) as if InsertNewNodeOrdered() was called for each of them in turn
+		template <typename TIterator> void InsertOrderedBatch(TIterator first, TIterator last){
+			int added = (int) _numbers.size();
+			for (; first != last; ++first){
+				_AddRow(first -> Number(), first -> Text());
+			}
+			_OrderNewRows(added);
+		}
+		//Delete the first n records with text search (all of them if n is -1). Returns the number deleted. Calls Rewind()
+		int DeleteNode(const std::string &search, int n = -1);
+		int DeleteNode(int number, int n = -1);		//Delete by number. See DeleteNode(const std::string &, int)
+		void Clear();		//Delete every record. The list is left empty and Unordered
+		//See LinkedList::DeleteNodesBatch(). keyOf is there to match it. The keys are always texts
+		template <typename TKeyOf> int DeleteNodesBatch(const std::vector<std::string> &keys, const std::vector<int> &counts, std::vector<int> &deleted, TKeyOf){
+			return DeleteNodesBatch(keys, counts, deleted);
+		}
+		int DeleteNodesBatch(const std::vector<std::string> &keys, const std::vector<int> &counts, std::vector<int> &deleted);
+
+		/*
+			Sort Related
+		*/
+		void Reverse();				//Reverse the list. Implicitly calls Rewind() Changes SortStatus
+		SortOrder GetSortStatus(){ return _SortStatus; }
+		//Declare that the list is already in SortBy order, without sorting it. The caller must make sure that it is.
+		void SetSortStatus(SortOrder SortBy){ _SortStatus = SortBy; }
+		//Stable sort. The rows are then laid out in list order, so walking the list reads the columns from start to end.
+		//Implicitly calls Rewind(). Changes SortStatus
+		void Sort(SortOrder SortBy = Ascending);
+
+	protected:
+		SortOrder _SortStatus;			//Stores the sort status of the list
+};
+
+#endif /* ColumnarList_H */
@@ -0,0 +1,320 @@
+/*
+	Yong Wen Chua
+	http://bit.ly/yongwen
+	Released under the LGPL license
+*/
+/*
+	ConcurrentLinkedList is an ordered singly linked list that many threads can insert into, delete from and search at
+	the same time, without any locks. It is ordered ascending on the int() value of the data. Like InsertNewNodeOrdered()
+	of an Ascending LinkedList, a new node goes before the nodes that have the same key.
+
+	The algorithm is Michael's lock-free list (based on Harris' list). A node is deleted in two steps: it is first marked
+	by setting the lowest bit of its link to the next node, which stops anything from being linked after it, and then
+	it is unlinked. Any thread that runs into a marked node helps to unlink it.
+
+	A node that has been unlinked may still be read by other threads, so it cannot be freed straight away. Memory is
+	reclaimed with hazard pointers: before a thread reads a node, it publishes a pointer to it in its record. A thread
+	that unlinks a node retires it, and retired nodes are only freed once no record points to them.
+
+	Unlike LinkedList, there is no internal pointer to iterate with, as it could not be shared between threads.
+	Data is copied out of the list by Find(), since a pointer to a node would not stay valid.
+	TData must not be changed once it is in the list.
+*/
+//These Macros ensure that the file is only #included once.
+#pragma once
+#ifndef ConcurrentLinkedList_H
+#define ConcurrentLinkedList_H
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <vector>
+#include <algorithm>
+#include <utility>
+
+template <typename TData=int> class ConcurrentLinkedList{
+	struct Node{
+		TData Data;
+		int Key;
+		std::atomic<uintptr_t> Next;		//Link to the next node. The lowest bit is set when this node is deleted
+
+		Node(TData data) : Data(std::move(data)), Key((int) Data), Next(0){}
+	};
+
+	//Every thread working on the list holds a record for the duration of each operation.
+	//Records are never freed until the list is destroyed. They are handed out again once released.
+	static const int HazardCount = 3;		//Pointers to the previous, current and next node of a search
+	static const size_t ScanThreshold = 64;	//Number of retired nodes a record collects before it tries to free them
+	struct Record{
+		std::atomic<bool> Active;
+		std::atomic<Node *> Hazards[HazardCount];
+		std::vector<Node *> Retired;		//Nodes unlinked while holding this record, not freed yet
+		Record *Next;
+
+		Record() : Active(true), Next(NULL){
+			for (int i = 0; i < HazardCount; i++){
+				Hazards[i].store(NULL);
+			}
+		}
+	};
+
+	//Holds a record for as long as it exists
+	class _Guard{
+		ConcurrentLinkedList *_list;
+		public:
+			Record *Held;
+			_Guard(ConcurrentLinkedList *list){
+				_list = list;
+				Held = list -> _Acquire();
+			}
+			~_Guard(){
+				_list -> _Release(Held);
+			}
+	};
+
+	std::atomic<uintptr_t> _head;		//Link to the first node. Never marked
+	std::atomic<Record *> _records;
+	std::atomic<int> _length;
+
+	//Links hold the pointer to the next node and the mark bit
+	static bool _Marked(uintptr_t link){ return (link & 1) != 0; }
+	static Node *_Pointer(uintptr_t link){ return reinterpret_cast<Node *>(link & ~(uintptr_t) 1); }
+	static uintptr_t _Link(Node *node, bool marked = false){ return reinterpret_cast<uintptr_t>(node) | (marked ? 1 : 0); }
+
+	Record *_Acquire();
+	void _Release(Record *record);
+	void _Retire(Record *record, Node *node);
+	void _Scan(Record *record);		//Frees the retired nodes of record that no record points to
+	//Looks for the first node whose key is not less than key (greater than key if pastEqual), unlinking marked nodes on the
+	//way. On return, *previous links to current, and current (if not NULL) is protected by a hazard pointer.
+	//Returns true if current has key.
+	bool _Find(Record *record, int key, std::atomic<uintptr_t> *&previous, Node *&current, bool pastEqual = false);
+
+	//Lists own their nodes, so they cannot be copied
+	ConcurrentLinkedList(const ConcurrentLinkedList &);
+	ConcurrentLinkedList &operator=(const ConcurrentLinkedList &);
+
+	public:
+		ConcurrentLinkedList();
+		//Destructor. No other thread may be using the list any more
+		~ConcurrentLinkedList();
+
+		//Number of nodes in the list. Only exact while no other thread is modifying the list
+		int Length(){ return _length.load(); }
+
+		//Insert a new node before the first node with a key not less than its own. Lock free.
+		void InsertNewNodeOrdered(TData data);
+		//Delete the first node whose int() value is key. Returns true if a node was deleted. Lock free.
+		bool DeleteNode(int key);
+		//Copy the data of the first node whose int() value is key into data. Returns false if there is none. Lock free.
+		bool Find(int key, TData &data);
+		bool Contains(int key);
+};
+
+/*
+	Constructor
+*/
+template <typename TData> ConcurrentLinkedList<TData>::ConcurrentLinkedList() : _head(0), _records(NULL), _length(0){
+}
+
+/*
+	Destructor
+*/
+template <typename TData> ConcurrentLinkedList<TData>::~ConcurrentLinkedList(){
+	Node *node = _Pointer(_head.load()), *next;
+	while (node != NULL){
+		next = _Pointer(node -> Next.load());
+		delete node;
+		node = next;
+	}
+	Record *record = _records.load(), *nextRecord;
+	while (record != NULL){
+		nextRecord = record -> Next;
+		for (size_t i = 0; i < record -> Retired.size(); i++){
+			delete record -> Retired[i];
+		}
+		delete record;
+		record = nextRecord;
+	}
+}
+
+/*
+	Hazard Pointers
+*/
+//_Acquire()
+//Takes the first record that is not in use, or adds a new one if all of them are
+template <typename TData> typename ConcurrentLinkedList<TData>::Record *ConcurrentLinkedList<TData>::_Acquire(){
+	for (Record *record = _records.load(); record != NULL; record = record -> Next){
+		bool inactive = false;
+		if (!record -> Active.load() && record -> Active.compare_exchange_strong(inactive, true)){
+			return record;
+		}
+	}
+	Record *record = new Record;		//Active from the start
+	Record *head = _records.load();
+	do{
+		record -> Next = head;
+	} while (!_records.compare_exchange_weak(head, record));
+	return record;
+}
+//_Release()
+template <typename TData> void ConcurrentLinkedList<TData>::_Release(Record *record){
+	for (int i = 0; i < HazardCount; i++){
+		record -> Hazards[i].store(NULL);
+	}
+	record -> Active.store(false);
+}
+//_Retire()
+template <typename TData> void ConcurrentLinkedList<TData>::_Retire(Record *record, Node *node){
+	record -> Retired.push_back(node);
+	if (record -> Retired.size() >= ScanThreshold){
+		_Scan(record);
+	}
+}
+//_Scan()
+template <typename TData> void ConcurrentLinkedList<TData>::_Scan(Record *record){
+	std::vector<Node *> hazards;
+	for (Record *other = _records.load(); other != NULL; other = other -> Next){
+		for (int i = 0; i < HazardCount; i++){
+			Node *hazard = other -> Hazards[i].load();
+			if (hazard != NULL){
+				hazards.push_back(hazard);
+			}
+		}
+	}
+	std::sort(hazards.begin(), hazards.end());
+	size_t kept = 0;
+	for (size_t i = 0; i < record -> Retired.size(); i++){
+		Node *node = record -> Retired[i];
+		if (std::binary_search(hazards.begin(), hazards.end(), node)){		//Still being read. Try again next time
+			record -> Retired[kept++] = node;
+		}
+		else{
+			delete node;
+		}
+	}
+	record -> Retired.resize(kept);
+}
+
+/*
+	Helper Methods
+*/
+//_Find()
+//Hazards[0] protects the next node, Hazards[1] the current node and Hazards[2] the node that previous belongs to.
+//After publishing a hazard pointer, the link it was read from is read again. If it has not changed, the node was still
+//in the list when it was protected, so it cannot have been freed.
+template <typename TData> bool ConcurrentLinkedList<TData>::_Find(Record *record, int key, std::atomic<uintptr_t> *&previous, Node *&current, bool pastEqual){
+	std::atomic<Node *> *hazards = record -> Hazards;
+	uintptr_t link, next;
+	while (true){		//Restart from the head whenever the list changed under us
+		previous = &_head;
+		link = previous -> load();
+		current = _Pointer(link);
+		hazards[1].store(current);
+		if (previous -> load() != link){
+			continue;
+		}
+		bool restart = false;
+		while (current != NULL){
+			next = current -> Next.load();
+			hazards[0].store(_Pointer(next));
+			if (current -> Next.load() != next || previous -> load() != _Link(current)){
+				restart = true;
+				break;
+			}
+			if (!_Marked(next)){
+				if (current -> Key > key || (current -> Key == key && !pastEqual)){
+					return (current -> Key == key);
+				}
+				previous = &current -> Next;
+				hazards[2].store(current);
+			}
+			else{			//current is being deleted. Help to unlink it
+				uintptr_t expected = _Link(current);
+				if (!previous -> compare_exchange_strong(expected, _Link(_Pointer(next)))){
+					restart = true;
+					break;
+				}
+				_Retire(record, current);
+			}
+			current = _Pointer(next);
+			hazards[1].store(current);
+		}
+		if (!restart){
+			return false;
+		}
+	}
+}
+
+/*
+	Modification Methods
+*/
+//InsertNewNodeOrdered()
+template <typename TData> void ConcurrentLinkedList<TData>::InsertNewNodeOrdered(TData data){
+	_Guard guard(this);
+	Node *node = new Node(std::move(data));
+	std::atomic<uintptr_t> *previous;
+	Node *current;
+	while (true){
+		_Find(guard.Held, node -> Key, previous, current);
+		node -> Next.store(_Link(current));
+		uintptr_t expected = _Link(current);
+		if (previous -> compare_exchange_strong(expected, _Link(node))){
+			_length++;
+			return;
+		}
+	}
+}
+//DeleteNode()
+template <typename TData> bool ConcurrentLinkedList<TData>::DeleteNode(int key){
+	_Guard guard(this);
+	std::atomic<uintptr_t> *previous;
+	Node *current;
+	while (true){
+		if (!_Find(guard.Held, key, previous, current)){
+			return false;
+		}
+		uintptr_t next = current -> Next.load();
+		if (_Marked(next)){		//Another thread got there first. Look again
+			continue;
+		}
+		if (!current -> Next.compare_exchange_strong(next, _Link(_Pointer(next), true))){
+			continue;
+		}
+		//current is now deleted. Unlink it, or leave it to the next search that runs into it
+		_length--;
+		uintptr_t expected = _Link(current);
+		if (previous -> compare_exchange_strong(expected, _Link(_Pointer(next)))){
+			guard.Held -> Hazards[1].store(NULL);
+			_Retire(guard.Held, current);
+		}
+		else{		//Something changed before current. Search past every node with key, as current may be behind other ones
+			_Find(guard.Held, key, previous, current, true);
+		}
+		return true;
+	}
+}
+
+/*
+	Searching Methods
+*/
+//Find()
+template <typename TData> bool ConcurrentLinkedList<TData>::Find(int key, TData &data){
+	_Guard guard(this);
+	std::atomic<uintptr_t> *previous;
+	Node *current;
+	if (!_Find(guard.Held, key, previous, current)){
+		return false;
+	}
+	data = current -> Data;		//current is protected by a hazard pointer until the guard is released
+	return true;
+}
+//Contains()
+template <typename TData> bool ConcurrentLinkedList<TData>::Contains(int key){
+	_Guard guard(this);
+	std::atomic<uintptr_t> *previous;
+	Node *current;
+	return _Find(guard.Held, key, previous, current);
+}
+
+#endif /* ConcurrentLinkedList_H */
@@ -0,0 +1,502 @@
+/*
+	Yong Wen Chua
+	http://bit.ly/yongwen
+	Released under the LGPL license
+*/
+/*
+	DoublyLinkedList is a linked list whose nodes, DoublyListNode<TData>, also link to the node before them.
+
+	It takes the same template parameters as LinkedList, and behaves like it. The batch inserts and the deletes are shared
+	with LinkedList through ListAlgorithms (see ListAlgorithms.h). Since every node knows the node before it:
+		- Any node can be unlinked in O(1) time with DeleteNode(Node), without knowing the node before it.
+		- The list can be iterated backwards, from RewindToLast() with Back().
+		- PushBack() and PopBack() take O(1) time, as do ordered inserts of nodes that go at the back.
+	Deletes through the hash index (see HashIndex.h) never need to walk the list.
+	The price is one more pointer in every node. There is no skip list index.
+
+	Because templates are used, we cannot separate the declaration from the definition into different files.
+*/
+//These Macros ensure that the file is only #included once.
+#pragma once
+#ifndef DoublyLinkedList_H
+#define DoublyLinkedList_H
+
+#include <new>
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <deque>
+#include <unordered_map>
+#include "ListNode.h"
+#include "NodeAllocator.h"
+#include "HashIndex.h"
+#include "ListAggregates.h"
+#include "SortPolicies.h"
+#include "Instrumentation.h"
+#include "ListAlgorithms.h"
+
+template <typename TData=int, typename TAllocator=SlabNodeAllocator<DoublyListNode<TData> >, typename THashIndex=NoHashIndex<TData>, typename TAggregates=NoAggregates<TData>,
+	typename TKeyOf=IntKeyOf<TData>, typename TCompare=KeyLess, typename TInstrumentation=NoInstrumentation> class DoublyLinkedList{
+	friend struct ListAlgorithms;
+	typedef TInstrumentation _Instrumentation;
+
+	TAllocator _allocator;					//Node allocator. Every node of the list is allocated from here
+	DoublyListNode<TData> *_firstNode;		//Pointer to the first node of the list
+	DoublyListNode<TData> *_lastNode;		//Pointer to the last node of the list
+	int _length;							//Number of nodes in the list
+	DoublyListNode<TData> *_current;		//Current node
+
+	THashIndex _hashIndex;				//Index on a key of the nodes, used to search by key. See HashIndex.h
+	TAggregates _aggregates;			//Sum, minimum and maximum of the nodes. See ListAggregates.h
+	TKeyOf _keyOf;
+	TCompare _compare;
+
+	void _LinkAfter(DoublyListNode<TData> *Node, DoublyListNode<TData> *previous);		//Link Node after previous, or at the head if previous is NULL
+	void _Unlink(DoublyListNode<TData> *Node);		//Unlink Node. Node is not destroyed
+	void _Unlink(DoublyListNode<TData> *Node, DoublyListNode<TData> *){ _Unlink(Node); }		//For ListAlgorithms. Node knows the node before it
+
+	//Compare two nodes. Returns true if node a has to be placed after node b in Order order (i.e. they are strictly out of order)
+	template <SortOrder Order> bool _SortHelper(DoublyListNode<TData> *a, DoublyListNode<TData> *b){
+		bool outOfOrder = SortDirection<Order>::Before(_compare, _keyOf(b -> Data()), _keyOf(a -> Data()));
+		TInstrumentation::Compared(outOfOrder);
+		return outOfOrder;
+	}
+	template <SortOrder Order> void _InsertOrdered(DoublyListNode<TData> *Node);
+	template <SortOrder Order> void _Sort();
+	//SearchForNode(), after the search is passed through SearchKey
+	template <typename TSearch> DoublyListNode<TData> *_SearchForNode(TSearch search);
+
+	//Lists own their nodes, so they cannot be copied
+	DoublyLinkedList(const DoublyLinkedList &);
+	DoublyLinkedList &operator=(const DoublyLinkedList &);
+
+	public:
+		//Constructor
+		DoublyLinkedList();
+		//Destructor
+		~DoublyLinkedList();
+
+		/*
+			Retrieving Methods
+		*/
+		int Length(){ return _length; }		//Returns the number of nodes
+		long long Sum(){ return _aggregates.Sum(_firstNode); }		//Sum of the int() values of the nodes
+		int Min(){ return _aggregates.Min(_firstNode); }			//Minimum of the int() values of the nodes. 0 if the list is empty
+		int Max(){ return _aggregates.Max(_firstNode); }			//Maximum of the int() values of the nodes. 0 if the list is empty
+		DoublyListNode<TData> *GetFirstNode(){ return _firstNode; }
+		DoublyListNode<TData> *GetLastNode(){ return _lastNode; }
+
+		/*
+			Iteration Methods. These behave like the ones in LinkedList, and can also go backwards
+		*/
+		void Rewind();						//Go to the first node
+		void RewindToLast();				//Go to the last node
+		DoublyListNode<TData> *Next();		//Go to the next node and return it
+		DoublyListNode<TData> *Back();		//Go to the previous node and return it
+		DoublyListNode<TData> *Previous();	//Return the node before the current node, without moving
+		DoublyListNode<TData> *Current();
+		//Search from the current node for the first node whose data == search, and go to it. Returns NULL if there is none.
+		//Searches from the first node are answered by the hash index, if it can.
+		template <typename TSearch> DoublyListNode<TData> *SearchForNode(TSearch search){ return _SearchForNode(SearchKey<TData>::Of(search)); }
+		bool IsFirst();
+		bool IsLast();
+
+		/*
+			Modifying Methods. These behave like the ones in LinkedList
+		*/
+		DoublyListNode<TData> *InsertNewNode(TData data);		//Insert at the head of the list. Sets SortStatus to Unordered
+		DoublyListNode<TData> *PushBack(TData data);			//Append at the end of the list in O(1). Sets SortStatus to Unordered
+		DoublyListNode<TData> *InsertNewNodeOrdered(TData data);		//Insert in the order determined by SortStatus
+		template <typename... TArgs> DoublyListNode<TData> *EmplaceNewNode(TArgs&&... args);
+		template <typename... TArgs> DoublyListNode<TData> *EmplaceBack(TArgs&&... args);
+		template <typename... TArgs> DoublyListNode<TData> *EmplaceNewNodeOrdered(TArgs&&... args);
+		//Insert the records in [first, last) as if InsertNewNodeOrdered() was called for each of them in turn, in one walk.
+		//The records are copied, or moved with std::move_iterators, as in LinkedList.
+		template <typename TIterator> void InsertOrderedBatch(TIterator first, TIterator last);
+		//Insert a new node right after or before RefNode in O(1). Sets SortStatus to Unordered
+		DoublyListNode<TData> *InsertNodeAfter(DoublyListNode<TData> *RefNode, TData data);
+		DoublyListNode<TData> *InsertNodeBefore(DoublyListNode<TData> *RefNode, TData data);
+
+		//Unlink and destroy Node, which must be in the list, in O(1). If it is the current node, the next node becomes current.
+		void DeleteNode(DoublyListNode<TData> *Node);
+		//Delete the first or the last node in O(1). Returns false if the list is empty
+		bool PopFront();
+		bool PopBack();
+		void Clear();		//Destroy every node. The list is left empty and Unordered, as it was constructed
+		//Delete the first n nodes whose data == data (all of them if n is -1). Returns the number deleted. Calls Rewind()
+		template <typename TSearch> int DeleteNode(TSearch data, int n = -1){
+			return ListAlgorithms::DeleteNode(*this, SearchKey<TData>::Of(data), n);
+		}
+		//See LinkedList::DeleteNodesBatch()
+		template <typename TSearch, typename TSearchOf> int DeleteNodesBatch(const std::vector<TSearch> &keys, const std::vector<int> &counts, std::vector<int> &deleted, TSearchOf keyOf){
+			return ListAlgorithms::DeleteNodesBatch(*this, keys, counts, deleted, keyOf);
+		}
+		int DeleteNodesBatch(const std::vector<int> &keys, const std::vector<int> &counts, std::vector<int> &deleted){
+			return DeleteNodesBatch(keys, counts, deleted, [](TData &data){ return (int) data; });
+		}
+
+		/*
+			Sort Related
+		*/
+		void Reverse();				//Reverse the list in place. Implicitly calls Rewind() Changes SortStatus
+		SortOrder GetSortStatus(){ return _SortStatus; }
+		//Declare that the list is already in SortBy order, without sorting it. The caller must make sure that it is.
+		void SetSortStatus(SortOrder SortBy){ _SortStatus = SortBy; }
+		void Sort(SortOrder SortBy = Ascending);		//Stable sort. Implicitly calls Rewind(). Changes SortStatus
+
+		/*
+			Node Factory Methods. See LinkedList
+		*/
+		template <typename... TArgs> DoublyListNode<TData> *EmplaceNode(TArgs&&... args);
+		void DestroyNode(DoublyListNode<TData> *Node);
+
+	protected:
+		SortOrder _SortStatus;			//Stores the sort status of the list
+};
+
+/*
+	Constructor
+*/
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> DoublyLinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::DoublyLinkedList(){
+	_firstNode = _lastNode = NULL;
+	_length = 0;
+	_SortStatus = Unordered;
+	Rewind();
+}
+
+/*
+	Destructor
+*/
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> DoublyLinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::~DoublyLinkedList(){
+	DoublyListNode<TData> *current = _firstNode, *next;
+	while (current != NULL){
+		next = current -> Next();
+		if (TAllocator::ReleasesAll){
+			TInstrumentation::Freed();
+			current -> ~DoublyListNode<TData>();
+		}
+		else{
+			DestroyNode(current);
+		}
+		current = next;
+	}
+}
+
+/*
+	Iteration Methods
+*/
+//Rewind()
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> void DoublyLinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::Rewind(){
+	_current = _firstNode;
+	TInstrumentation::Rewound();
+}
+//RewindToLast()
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> void DoublyLinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::RewindToLast(){
+	_current = _lastNode;
+}
+//Next()
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> DoublyListNode<TData> *DoublyLinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::Next(){
+	if (_current == NULL){
+		return NULL;
+	}
+	_current = _current -> Next();
+	return _current;
+}
+//Back()
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> DoublyListNode<TData> *DoublyLinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::Back(){
+	if (_current == NULL){
+		return NULL;
+	}
+	_current = _current -> Previous();
+	return _current;
+}
+//Previous()
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> DoublyListNode<TData> *DoublyLinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::Previous(){
+	return (_current == NULL) ? NULL : _current -> Previous();
+}
+//Current()
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> DoublyListNode<TData> *DoublyLinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::Current(){
+	return _current;
+}
+//IsFirst()
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> bool DoublyLinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::IsFirst(){
+	return (_current == _firstNode);
+}
+//IsLast()
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> bool DoublyLinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::IsLast(){
+	return (_current == NULL || _current -> Next() == NULL);
+}
+//SearchForNode()
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> template <typename TSearch> DoublyListNode<TData> *DoublyLinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::_SearchForNode(TSearch search){
+	ListNode<TData> *node, *previous;
+	if (IsFirst() && _hashIndex.Find(search, _firstNode, node, previous)){		//Searching from the start. Ask the hash index
+		_current = static_cast<DoublyListNode<TData> *>(node);
+		return _current;
+	}
+	while (_current != NULL && !(_current -> Data() == search)){
+		TInstrumentation::Stepped();
+		_current = _current -> Next();
+	}
+	return _current;
+}
+
+/*
+	Helper Methods
+*/
+//_LinkAfter()
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> void DoublyLinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::_LinkAfter(DoublyListNode<TData> *Node, DoublyListNode<TData> *previous){
+	DoublyListNode<TData> *next = (previous == NULL) ? _firstNode : previous -> Next();
+	Node -> SetPrevious(previous);
+	Node -> SetNext(next);
+	if (previous == NULL){
+		_firstNode = Node;
+	}
+	else{
+		previous -> SetNext(Node);
+	}
+	if (next == NULL){
+		_lastNode = Node;
+	}
+	else{
+		next -> SetPrevious(Node);
+	}
+	_length++;
+	_hashIndex.Linked(Node, previous);
+	_aggregates.Added(Node);
+}
+//_Unlink()
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> void DoublyLinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::_Unlink(DoublyListNode<TData> *Node){
+	DoublyListNode<TData> *previous = Node -> Previous(), *next = Node -> Next();
+	_hashIndex.Unlinked(Node, previous);
+	_aggregates.Removed(Node);
+	if (previous == NULL){
+		_firstNode = next;
+	}
+	else{
+		previous -> SetNext(next);
+	}
+	if (next == NULL){
+		_lastNode = previous;
+	}
+	else{
+		next -> SetPrevious(previous);
+	}
+	if (_current == Node){
+		_current = next;
+	}
+	_length--;
+}
+
+/*
+	Modifying Methods
+*/
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> DoublyListNode<TData> *DoublyLinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::InsertNewNode(TData data){
+	return EmplaceNewNode(std::move(data));
+}
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> template <typename... TArgs> DoublyListNode<TData> *DoublyLinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::EmplaceNewNode(TArgs&&... args){
+	DoublyListNode<TData> *Node = EmplaceNode(std::forward<TArgs>(args)...);
+	_LinkAfter(Node, NULL);
+	_SortStatus = Unordered;
+	return Node;
+}
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> DoublyListNode<TData> *DoublyLinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::PushBack(TData data){
+	return EmplaceBack(std::move(data));
+}
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> template <typename... TArgs> DoublyListNode<TData> *DoublyLinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::EmplaceBack(TArgs&&... args){
+	DoublyListNode<TData> *Node = EmplaceNode(std::forward<TArgs>(args)...);
+	_LinkAfter(Node, _lastNode);
+	_SortStatus = Unordered;
+	return Node;
+}
+//InsertNewNodeOrdered()
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> DoublyListNode<TData> *DoublyLinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::InsertNewNodeOrdered(TData data){
+	return EmplaceNewNodeOrdered(std::move(data));
+}
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> template <typename... TArgs> DoublyListNode<TData> *DoublyLinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::EmplaceNewNodeOrdered(TArgs&&... args){
+	DoublyListNode<TData> *Node = EmplaceNode(std::forward<TArgs>(args)...);
+	switch (_SortStatus){
+		case Ascending:
+			_InsertOrdered<Ascending>(Node);
+			break;
+		case Descending:
+			_InsertOrdered<Descending>(Node);
+			break;
+		default:
+			_LinkAfter(Node, NULL);			//Unordered? Just add the node to the head of the list!
+			break;
+	}
+	return Node;
+}
+//Helper method. The node goes before the first node it does not have to be placed after. If it goes after the last
+//node, it is appended straight away, so that records arriving in order are inserted in O(1).
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> template <SortOrder Order> void DoublyLinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::_InsertOrdered(DoublyListNode<TData> *Node){
+	if (_lastNode == NULL || _SortHelper<Order>(Node, _lastNode)){
+		_LinkAfter(Node, _lastNode);
+		return;
+	}
+	DoublyListNode<TData> *current = _firstNode;
+	while (_SortHelper<Order>(Node, current)){		//Stops at _lastNode at the latest
+		TInstrumentation::Stepped();
+		current = current -> Next();
+	}
+	_LinkAfter(Node, current -> Previous());
+}
+//InsertOrderedBatch()
+//The batch is merged into the list in one walk by ListAlgorithms::InsertOrderedBatch()
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> template <typename TIterator> void DoublyLinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::InsertOrderedBatch(TIterator first, TIterator last){
+	std::vector<DoublyListNode<TData> *> batch;
+	for (; first != last; ++first){
+		batch.push_back(EmplaceNode(*first));
+	}
+	if (_SortStatus == Unordered){
+		for (size_t i = 0; i < batch.size(); i++){
+			_LinkAfter(batch[i], NULL);
+		}
+		return;
+	}
+	ListAlgorithms::InsertOrderedBatch(*this, batch);
+}
+//InsertNodeAfter()
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> DoublyListNode<TData> *DoublyLinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::InsertNodeAfter(DoublyListNode<TData> *RefNode, TData data){
+	DoublyListNode<TData> *Node = EmplaceNode(std::move(data));
+	_LinkAfter(Node, RefNode);
+	_SortStatus = Unordered;
+	return Node;
+}
+//InsertNodeBefore()
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> DoublyListNode<TData> *DoublyLinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::InsertNodeBefore(DoublyListNode<TData> *RefNode, TData data){
+	DoublyListNode<TData> *Node = EmplaceNode(std::move(data));
+	_LinkAfter(Node, RefNode -> Previous());
+	_SortStatus = Unordered;
+	return Node;
+}
+
+/*
+	Deleting Methods
+*/
+//DeleteNode()
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> void DoublyLinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::DeleteNode(DoublyListNode<TData> *Node){
+	_Unlink(Node);
+	DestroyNode(Node);
+}
+//PopFront()
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> bool DoublyLinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::PopFront(){
+	if (_firstNode == NULL){
+		return false;
+	}
+	DeleteNode(_firstNode);
+	return true;
+}
+//PopBack()
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> bool DoublyLinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::PopBack(){
+	if (_lastNode == NULL){
+		return false;
+	}
+	DeleteNode(_lastNode);
+	return true;
+}
+//Clear()
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> void DoublyLinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::Clear(){
+	DoublyListNode<TData> *current = _firstNode, *next;
+	while (current != NULL){
+		next = current -> Next();
+		DestroyNode(current);
+		current = next;
+	}
+	_firstNode = _lastNode = NULL;
+	_length = 0;
+	_SortStatus = Unordered;
+	_hashIndex.Reset();
+	_aggregates.Reset();
+	Rewind();
+}
+
+/*
+	Sort Related
+*/
+//Reverse()
+//Swaps the links of every node
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> void DoublyLinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::Reverse(){
+	if (_length < 2){
+		return;
+	}
+	DoublyListNode<TData> *node = _firstNode, *next;
+	while (node != NULL){
+		next = node -> Next();
+		node -> SetNext(node -> Previous());
+		node -> SetPrevious(next);
+		node = next;
+	}
+	std::swap(_firstNode, _lastNode);
+	_hashIndex.Reset();
+
+	Rewind();
+
+	switch (_SortStatus){
+		case Ascending:
+			_SortStatus = Descending;
+			break;
+		case Descending:
+			_SortStatus = Ascending;
+			break;
+		default:
+			_SortStatus = Unordered;
+			break;
+	}
+}
+//Sort()
+//As in UnrolledLinkedList, the nodes are sorted stably through an array of pointers to them, and relinked in order.
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> void DoublyLinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::Sort(SortOrder SortBy){
+	if (SortBy == Unordered){
+		return;
+	}
+	if (_length < 2){
+		return;
+	}
+	if (SortBy == Ascending){
+		_Sort<Ascending>();
+	}
+	else{
+		_Sort<Descending>();
+	}
+	_SortStatus = SortBy;
+	_hashIndex.Reset();
+	Rewind();
+}
+//Helper method. Sorts the list in Order order
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> template <SortOrder Order> void DoublyLinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::_Sort(){
+	std::vector<DoublyListNode<TData> *> nodes;
+	nodes.reserve(_length);
+	for (DoublyListNode<TData> *node = _firstNode; node != NULL; node = node -> Next()){
+		nodes.push_back(node);
+	}
+	std::stable_sort(nodes.begin(), nodes.end(), [this](DoublyListNode<TData> *a, DoublyListNode<TData> *b){
+		return this -> template _SortHelper<Order>(b, a);
+	});
+	DoublyListNode<TData> *previous = NULL;
+	for (size_t i = 0; i < nodes.size(); i++){
+		nodes[i] -> SetPrevious(previous);
+		if (previous != NULL){
+			previous -> SetNext(nodes[i]);
+		}
+		previous = nodes[i];
+	}
+	previous -> SetNext(NULL);
+	_firstNode = nodes.front();
+	_lastNode = nodes.back();
+}
+
+/*
+	Node Factory Methods
+*/
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> template <typename... TArgs> DoublyListNode<TData> *DoublyLinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::EmplaceNode(TArgs&&... args){
+	TInstrumentation::Allocated();
+	return new (_allocator.Allocate()) DoublyListNode<TData>(typename ListNode<TData>::InPlace(), std::forward<TArgs>(args)...);
+}
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> void DoublyLinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::DestroyNode(DoublyListNode<TData> *Node){
+	TInstrumentation::Freed();
+	Node -> ~DoublyListNode<TData>();
+	_allocator.Deallocate(Node);
+}
+
+#endif /* DoublyLinkedList_H */
@@ -0,0 +1,179 @@
+/*
+	Yong Wen Chua
+	http://bit.ly/yongwen
+	Released under the LGPL license
+*/
+/*
+	Hash index policies for LinkedList.
+
+	A hash index maps a key taken from the data of each node (e.g. the text of ListNodeData) to the nodes holding it, along
+	with the node before each of them so that a node found can be unlinked straight away. LinkedList uses it to search for
+	and delete nodes by key in expected O(1) time instead of walking the list.
+
+	A policy has to implement the following. LinkedList calls them as it modifies the list.
+		- void Linked(ListNode<TData> *Node, ListNode<TData> *Previous)
+			Node has been linked into the list after Previous (NULL if Node is now the first node)
+		- void Unlinked(ListNode<TData> *Node, ListNode<TData> *Previous)
+			Node is being unlinked from after Previous. Its data and link to the next node are still intact.
+		- void Reset()
+			The nodes have been rearranged as a whole (e.g. sorted or reversed). The index is rebuilt when next needed.
+		- template <typename TSearch> bool Find(TSearch search, ListNode<TData> *First, ListNode<TData> *&Node, ListNode<TData> *&Previous)
+			Looks up the first node in the list matching search, and the node before it. Node is set to NULL if there is none.
+			Returns false if the index cannot be used for this type of search, in which case the list has to be walked.
+
+	NoHashIndex does nothing and is the default. HashIndex indexes the nodes on the key returned by the functor TKeyOf.
+*/
+//These Macros ensure that the file is only #included once.
+#pragma once
+#ifndef HashIndex_H
+#define HashIndex_H
+
+#include <cstddef>
+#include <map>
+#include <unordered_map>
+#include "ListNode.h"
+
+template <typename TData> class NoHashIndex{
+	public:
+		void Linked(ListNode<TData> *, ListNode<TData> *){}
+		void Unlinked(ListNode<TData> *, ListNode<TData> *){}
+		void Reset(){}
+		template <typename TSearch> bool Find(TSearch, ListNode<TData> *, ListNode<TData> *&, ListNode<TData> *&){
+			return false;
+		}
+};
+
+/*
+	There may be more than one node with the same key, and searches must find the first of them in the list.
+	To tell which comes first, every node is given an order label, which increases along the list. A new node takes a label
+	between those of its neighbours. If there is no room left between them, the index is rebuilt with evenly spaced labels.
+	The nodes with the same key are kept in a map ordered by label, so the first one is always at the front.
+*/
+template <typename TData, typename TKey, typename TKeyOf> class HashIndex{
+	typedef unsigned long long Label;
+	typedef std::map<Label, ListNode<TData> *> NodesByLabel;
+	struct Entry{
+		ListNode<TData> *Previous;		//Node before this node in the list
+		Label Order;					//Order label of this node
+	};
+
+	static const Label Spacing = 1ULL << 32;		//Gap between labels when they are assigned afresh
+	static const Label Start = 1ULL << 62;			//Label of the first node when labels are assigned afresh
+
+	std::unordered_map<ListNode<TData> *, Entry> _entries;
+	std::unordered_map<TKey, NodesByLabel> _keys;
+	bool _built;
+	TKeyOf _keyOf;
+
+	void _Add(ListNode<TData> *node, ListNode<TData> *previous, Label order){
+		Entry &entry = _entries[node];
+		entry.Previous = previous;
+		entry.Order = order;
+		_keys[_keyOf(node -> Data())][order] = node;
+	}
+	void _Build(ListNode<TData> *first){
+		Clear();
+		ListNode<TData> *previous = NULL;
+		Label order = Start;
+		for (ListNode<TData> *node = first; node != NULL; node = node -> Next()){
+			_Add(node, previous, order);
+			previous = node;
+			order += Spacing;
+		}
+		_built = true;
+	}
+
+	public:
+		HashIndex(){
+			_built = false;
+		}
+
+		//Drops the index
+		void Clear(){
+			_entries.clear();
+			_keys.clear();
+			_built = false;
+		}
+		void Reset(){
+			Clear();
+		}
+
+		void Linked(ListNode<TData> *Node, ListNode<TData> *Previous){
+			if (!_built){
+				return;
+			}
+			ListNode<TData> *next = Node -> Next();
+			Label before = (Previous == NULL) ? 0 : _entries[Previous].Order;
+			Label order;
+			bool room;
+			if (next == NULL){
+				if (Previous == NULL){		//The only node
+					order = Start;
+					room = true;
+				}
+				else{
+					order = before + Spacing;
+					room = (order > before);
+				}
+			}
+			else{
+				Entry &nextEntry = _entries[next];
+				nextEntry.Previous = Node;
+				Label after = nextEntry.Order;
+				if (Previous == NULL){
+					order = (after > Spacing) ? after - Spacing : after / 2;
+					room = (after > 0);
+				}
+				else{
+					order = before + (after - before) / 2;
+					room = (after - before >= 2);
+				}
+			}
+			if (!room){			//No label left between the neighbours. Rebuild the index when it is next needed
+				Clear();
+				return;
+			}
+			_Add(Node, Previous, order);
+		}
+
+		void Unlinked(ListNode<TData> *Node, ListNode<TData> *Previous){
+			if (!_built){
+				return;
+			}
+			typename std::unordered_map<ListNode<TData> *, Entry>::iterator entry = _entries.find(Node);
+			if (entry == _entries.end()){
+				return;
+			}
+			typename std::unordered_map<TKey, NodesByLabel>::iterator key = _keys.find(_keyOf(Node -> Data()));
+			if (key != _keys.end()){
+				key -> second.erase(entry -> second.Order);
+				if (key -> second.empty()){
+					_keys.erase(key);
+				}
+			}
+			_entries.erase(entry);
+			if (Node -> Next() != NULL){
+				_entries[Node -> Next()].Previous = Previous;
+			}
+		}
+
+		//Searches with a key are answered by the index. Any other type of search cannot be.
+		template <typename TSearch> bool Find(TSearch, ListNode<TData> *, ListNode<TData> *&, ListNode<TData> *&){
+			return false;
+		}
+		bool Find(const TKey &Search, ListNode<TData> *First, ListNode<TData> *&Node, ListNode<TData> *&Previous){
+			if (!_built){
+				_Build(First);
+			}
+			typename std::unordered_map<TKey, NodesByLabel>::iterator key = _keys.find(Search);
+			if (key == _keys.end()){
+				Node = Previous = NULL;
+				return true;
+			}
+			Node = key -> second.begin() -> second;
+			Previous = _entries[Node].Previous;
+			return true;
+		}
+};
+
+#endif /* HashIndex_H */
@@ -0,0 +1,90 @@
+/*
+	Yong Wen Chua
+	http://bit.ly/yongwen
+	Released under the LGPL license
+*/
+/*
+	Operation counters and command timing. See Instrumentation.h
+*/
+#include "Instrumentation.h"
+#include <cctype>
+#include <cstdio>
+#include <string>
+using namespace std;
+
+atomic<long long> OperationCounters::_allocations(0), OperationCounters::_frees(0), OperationCounters::_comparisons(0),
+	OperationCounters::_outOfOrder(0), OperationCounters::_steps(0), OperationCounters::_rewinds(0);
+
+void OperationCounters::Reset(){
+	_allocations = _frees = _comparisons = _outOfOrder = _steps = _rewinds = 0;
+}
+
+void OperationCounters::Dump(ostream &out){
+	out << "Node allocations: " << _allocations << endl;
+	out << "Node frees: " << _frees << endl;
+	out << "Comparisons: " << _comparisons << endl;
+	out << "Out of order comparisons: " << _outOfOrder << endl;
+	out << "Traversal steps: " << _steps << endl;
+	out << "Rewinds: " << _rewinds << endl;
+}
+
+//Formats a time in nanoseconds with a unit that keeps it short, e.g. 512ns, 1.5us, 20.3ms
+static string FormatTime(long long nanoseconds){
+	static const char *units[] = { "ns", "us", "ms", "s" };
+	double time = (double) nanoseconds;
+	int unit = 0;
+	while (time >= 1000 && unit < 3){
+		time /= 1000;
+		unit++;
+	}
+	char buffer[32];
+	snprintf(buffer, sizeof(buffer), (unit == 0) ? "%.0f%s" : "%.1f%s", time, units[unit]);
+	return buffer;
+}
+
+CommandLatencies::CommandLatencies(){
+	for (int i = 0; i < 128; i++){
+		Histogram &histogram = _commands[i];
+		histogram.Count = histogram.Total = histogram.Min = histogram.Max = 0;
+		for (int bucket = 0; bucket < Buckets; bucket++){
+			histogram.Counts[bucket] = 0;
+		}
+	}
+	Start();
+}
+
+void CommandLatencies::Stop(char command){
+	long long time = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - _start).count();
+	Histogram &histogram = _commands[tolower((unsigned char) command) & 127];
+	if (histogram.Count == 0 || time < histogram.Min){
+		histogram.Min = time;
+	}
+	if (time > histogram.Max){
+		histogram.Max = time;
+	}
+	histogram.Count++;
+	histogram.Total += time;
+	int bucket = 0;
+	while (bucket < Buckets - 1 && (time >> (bucket + 1)) != 0){
+		bucket++;
+	}
+	histogram.Counts[bucket]++;
+}
+
+void CommandLatencies::Dump(ostream &out){
+	for (int command = 0; command < 128; command++){
+		const Histogram &histogram = _commands[command];
+		if (histogram.Count == 0){
+			continue;
+		}
+		out << "Command '" << (char) command << "': " << histogram.Count << " timed, total " << FormatTime(histogram.Total)
+			<< ", mean " << FormatTime(histogram.Total / histogram.Count) << ", min " << FormatTime(histogram.Min)
+			<< ", max " << FormatTime(histogram.Max) << endl;
+		for (int bucket = 0; bucket < Buckets; bucket++){
+			if (histogram.Counts[bucket] != 0){
+				long long low = (bucket == 0) ? 0 : (1LL << bucket), high = (bucket < Buckets - 2) ? (1LL << (bucket + 1)) : histogram.Max;
+				out << "\t" << FormatTime(low) << " - " << FormatTime(high) << ": " << histogram.Counts[bucket] << endl;
+			}
+		}
+	}
+}
@@ -0,0 +1,89 @@
+/*
+	Yong Wen Chua
+	http://bit.ly/yongwen
+	Released under the LGPL license
+*/
+/*
+	Instrumentation policies for LinkedList, and timing of the commands of the command file.
+
+	An instrumentation policy is told about the work a list does. A policy has to implement the following static methods.
+		- void Allocated()					A node has been allocated
+		- void Freed()						A node has been freed
+		- void Compared(bool outOfOrder)	_SortHelper() compared two nodes. outOfOrder is its result: the first node has to be
+											placed after the second. Not every such comparison moves a node
+		- void Stepped()					SearchForNode(), DeleteNode() or an ordered insert moved one node along the list
+		- void Rewound()					Rewind() was called
+
+	NoInstrumentation does nothing. Its methods are empty and inline, so a list that uses it compiles to the same code
+	as it would without them.
+	OperationCounters counts each of these. The counts are shared by all the lists that use it, so the shards of a
+	ShardedLinkedList add up, and are atomic, as Sort() may compare nodes on several threads.
+
+	CommandLatencies keeps a histogram of how long each command took, by command. NoCommandLatencies does nothing.
+	Define USE_INSTRUMENTATION at compile time for the program to use OperationCounters and CommandLatencies (see Operation.h).
+*/
+//These Macros ensure that the file is only #included once.
+#pragma once
+#ifndef Instrumentation_H
+#define Instrumentation_H
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+
+class NoInstrumentation{
+	public:
+		static void Allocated(){}
+		static void Freed(){}
+		static void Compared(bool){}
+		static void Stepped(){}
+		static void Rewound(){}
+};
+
+class OperationCounters{
+	static std::atomic<long long> _allocations, _frees, _comparisons, _outOfOrder, _steps, _rewinds;
+
+	public:
+		static void Allocated(){ _allocations.fetch_add(1, std::memory_order_relaxed); }
+		static void Freed(){ _frees.fetch_add(1, std::memory_order_relaxed); }
+		static void Compared(bool outOfOrder){
+			_comparisons.fetch_add(1, std::memory_order_relaxed);
+			if (outOfOrder){
+				_outOfOrder.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+		static void Stepped(){ _steps.fetch_add(1, std::memory_order_relaxed); }
+		static void Rewound(){ _rewinds.fetch_add(1, std::memory_order_relaxed); }
+
+		static void Reset();				//Set every count back to 0
+		static void Dump(std::ostream &out);	//Write the counts
+};
+
+class NoCommandLatencies{
+	public:
+		void Start(){}
+		void Stop(char){}
+		void Dump(std::ostream &){}
+};
+
+class CommandLatencies{
+	public:
+		static const int Buckets = 64;		//Bucket i holds the times from 2^i to 2^(i+1) - 1 nanoseconds
+
+	private:
+		struct Histogram{
+			long long Count, Total, Min, Max;		//In nanoseconds
+			long long Counts[Buckets];		//By bucket
+		};
+		Histogram _commands[128];			//By command, in lower case
+		std::chrono::steady_clock::time_point _start;
+
+	public:
+		CommandLatencies();
+
+		void Start(){ _start = std::chrono::steady_clock::now(); }		//A command starts
+		void Stop(char command);		//command has ended. Counts the time since Start()
+		void Dump(std::ostream &out);	//Write the histogram of each command that was timed
+};
+
+#endif /* Instrumentation_H */
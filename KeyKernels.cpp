@@ -0,0 +1,331 @@
+/*
+	Yong Wen Chua
+	http://bit.ly/yongwen
+	Released under the LGPL license
+*/
+/*
+	Kernels over arrays of int keys, with runtime CPU dispatch. See KeyKernels.h
+*/
+#include "KeyKernels.h"
+
+//Use of EVIL MACROS to detect x86 CPUs, and the compiler's way of building a function for a given instruction set.
+//MSVC builds any intrinsic without being asked. GCC and Clang have to be told per function.
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+	#define KEY_KERNELS_X86
+	#include <immintrin.h>
+	#ifdef _MSC_VER
+		#include <intrin.h>
+		#define KERNEL_TARGET(set)
+	#else
+		#define KERNEL_TARGET(set) __attribute__((target(set)))
+	#endif
+#endif
+
+//Number of bits set in a mask of vector lanes
+static int Lanes(unsigned int mask){
+	int lanes = 0;
+	while (mask != 0){
+		mask &= mask - 1;
+		lanes++;
+	}
+	return lanes;
+}
+//Index of the lowest bit set in a mask of vector lanes, which is not 0
+static int FirstLane(unsigned int mask){
+	int lane = 0;
+	while ((mask & 1) == 0){
+		mask >>= 1;
+		lane++;
+	}
+	return lane;
+}
+
+/*
+	Plain versions. These also finish off the keys left over by the vector versions
+*/
+static long long SumPlain(const int *keys, size_t count){
+	long long sum = 0;
+	for (size_t i = 0; i < count; i++){
+		sum += keys[i];
+	}
+	return sum;
+}
+static int MinPlain(const int *keys, size_t count){
+	int min = keys[0];
+	for (size_t i = 1; i < count; i++){
+		if (keys[i] < min){
+			min = keys[i];
+		}
+	}
+	return min;
+}
+static int MaxPlain(const int *keys, size_t count){
+	int max = keys[0];
+	for (size_t i = 1; i < count; i++){
+		if (keys[i] > max){
+			max = keys[i];
+		}
+	}
+	return max;
+}
+static size_t FindPlain(const int *keys, size_t count, int key){
+	size_t i = 0;
+	while (i < count && keys[i] != key){
+		i++;
+	}
+	return i;
+}
+static size_t CountInRangePlain(const int *keys, size_t count, int low, int high){
+	size_t inRange = 0;
+	for (size_t i = 0; i < count; i++){
+		inRange += (keys[i] >= low && keys[i] <= high) ? 1 : 0;
+	}
+	return inRange;
+}
+
+#ifdef KEY_KERNELS_X86
+
+/*
+	SSE4.1 versions. 4 keys at a time
+*/
+static KERNEL_TARGET("sse4.1") long long SumSSE41(const int *keys, size_t count){
+	__m128i low = _mm_setzero_si128(), high = _mm_setzero_si128();		//Two 64 bit sums each, so that they cannot overflow
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4){
+		__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(keys + i));
+		low = _mm_add_epi64(low, _mm_cvtepi32_epi64(block));
+		high = _mm_add_epi64(high, _mm_cvtepi32_epi64(_mm_srli_si128(block, 8)));
+	}
+	long long sums[2];
+	_mm_storeu_si128(reinterpret_cast<__m128i *>(sums), _mm_add_epi64(low, high));
+	return sums[0] + sums[1] + SumPlain(keys + i, count - i);
+}
+static KERNEL_TARGET("sse4.1") int MinSSE41(const int *keys, size_t count){
+	if (count < 4){
+		return MinPlain(keys, count);
+	}
+	__m128i min = _mm_loadu_si128(reinterpret_cast<const __m128i *>(keys));
+	size_t i = 4;
+	for (; i + 4 <= count; i += 4){
+		min = _mm_min_epi32(min, _mm_loadu_si128(reinterpret_cast<const __m128i *>(keys + i)));
+	}
+	int lanes[4];
+	_mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), min);
+	int result = MinPlain(lanes, 4);
+	if (i < count){
+		int rest = MinPlain(keys + i, count - i);
+		result = (rest < result) ? rest : result;
+	}
+	return result;
+}
+static KERNEL_TARGET("sse4.1") int MaxSSE41(const int *keys, size_t count){
+	if (count < 4){
+		return MaxPlain(keys, count);
+	}
+	__m128i max = _mm_loadu_si128(reinterpret_cast<const __m128i *>(keys));
+	size_t i = 4;
+	for (; i + 4 <= count; i += 4){
+		max = _mm_max_epi32(max, _mm_loadu_si128(reinterpret_cast<const __m128i *>(keys + i)));
+	}
+	int lanes[4];
+	_mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), max);
+	int result = MaxPlain(lanes, 4);
+	if (i < count){
+		int rest = MaxPlain(keys + i, count - i);
+		result = (rest > result) ? rest : result;
+	}
+	return result;
+}
+static KERNEL_TARGET("sse4.1") size_t FindSSE41(const int *keys, size_t count, int key){
+	__m128i wanted = _mm_set1_epi32(key);
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4){
+		__m128i equal = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(keys + i)), wanted);
+		unsigned int mask = (unsigned int) _mm_movemask_ps(_mm_castsi128_ps(equal));
+		if (mask != 0){
+			return i + FirstLane(mask);
+		}
+	}
+	return i + FindPlain(keys + i, count - i, key);
+}
+static KERNEL_TARGET("sse4.1") size_t CountInRangeSSE41(const int *keys, size_t count, int low, int high){
+	__m128i lows = _mm_set1_epi32(low), highs = _mm_set1_epi32(high);
+	size_t inRange = 0, i = 0;
+	for (; i + 4 <= count; i += 4){
+		__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(keys + i));
+		__m128i outside = _mm_or_si128(_mm_cmplt_epi32(block, lows), _mm_cmpgt_epi32(block, highs));
+		inRange += 4 - Lanes((unsigned int) _mm_movemask_ps(_mm_castsi128_ps(outside)));
+	}
+	return inRange + CountInRangePlain(keys + i, count - i, low, high);
+}
+
+/*
+	AVX2 versions. 8 keys at a time
+*/
+static KERNEL_TARGET("avx2") long long SumAVX2(const int *keys, size_t count){
+	__m256i low = _mm256_setzero_si256(), high = _mm256_setzero_si256();		//Four 64 bit sums each
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8){
+		__m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(keys + i));
+		low = _mm256_add_epi64(low, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(block)));
+		high = _mm256_add_epi64(high, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(block, 1)));
+	}
+	long long sums[4];
+	_mm256_storeu_si256(reinterpret_cast<__m256i *>(sums), _mm256_add_epi64(low, high));
+	return sums[0] + sums[1] + sums[2] + sums[3] + SumPlain(keys + i, count - i);
+}
+static KERNEL_TARGET("avx2") int MinAVX2(const int *keys, size_t count){
+	if (count < 8){
+		return MinPlain(keys, count);
+	}
+	__m256i min = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(keys));
+	size_t i = 8;
+	for (; i + 8 <= count; i += 8){
+		min = _mm256_min_epi32(min, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(keys + i)));
+	}
+	int lanes[8];
+	_mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes), min);
+	int result = MinPlain(lanes, 8);
+	if (i < count){
+		int rest = MinPlain(keys + i, count - i);
+		result = (rest < result) ? rest : result;
+	}
+	return result;
+}
+static KERNEL_TARGET("avx2") int MaxAVX2(const int *keys, size_t count){
+	if (count < 8){
+		return MaxPlain(keys, count);
+	}
+	__m256i max = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(keys));
+	size_t i = 8;
+	for (; i + 8 <= count; i += 8){
+		max = _mm256_max_epi32(max, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(keys + i)));
+	}
+	int lanes[8];
+	_mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes), max);
+	int result = MaxPlain(lanes, 8);
+	if (i < count){
+		int rest = MaxPlain(keys + i, count - i);
+		result = (rest > result) ? rest : result;
+	}
+	return result;
+}
+static KERNEL_TARGET("avx2") size_t FindAVX2(const int *keys, size_t count, int key){
+	__m256i wanted = _mm256_set1_epi32(key);
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8){
+		__m256i equal = _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(keys + i)), wanted);
+		unsigned int mask = (unsigned int) _mm256_movemask_ps(_mm256_castsi256_ps(equal));
+		if (mask != 0){
+			return i + FirstLane(mask);
+		}
+	}
+	return i + FindPlain(keys + i, count - i, key);
+}
+static KERNEL_TARGET("avx2") size_t CountInRangeAVX2(const int *keys, size_t count, int low, int high){
+	__m256i lows = _mm256_set1_epi32(low), highs = _mm256_set1_epi32(high);
+	size_t inRange = 0, i = 0;
+	for (; i + 8 <= count; i += 8){
+		__m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(keys + i));
+		__m256i outside = _mm256_or_si256(_mm256_cmpgt_epi32(lows, block), _mm256_cmpgt_epi32(block, highs));
+		inRange += 8 - Lanes((unsigned int) _mm256_movemask_ps(_mm256_castsi256_ps(outside)));
+	}
+	return inRange + CountInRangePlain(keys + i, count - i, low, high);
+}
+
+//Returns true if the CPU, and the operating system, support set
+static bool Supports(KeyKernelSet set){
+	if (set == PlainKernels){
+		return true;
+	}
+	#ifdef _MSC_VER
+		int info[4];
+		__cpuid(info, 1);
+		bool sse41 = (info[2] & (1 << 19)) != 0;
+		if (set == SSE41Kernels){
+			return sse41;
+		}
+		bool avx = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 6) == 6;		//The OS saves the AVX registers
+		__cpuidex(info, 7, 0);
+		return sse41 && avx && (info[1] & (1 << 5)) != 0;
+	#else
+		__builtin_cpu_init();
+		return (set == SSE41Kernels) ? __builtin_cpu_supports("sse4.1") != 0 : __builtin_cpu_supports("avx2") != 0;
+	#endif
+}
+
+#else
+
+static bool Supports(KeyKernelSet set){
+	return (set == PlainKernels);
+}
+
+#endif
+
+//The kernels in use
+struct Kernels{
+	KeyKernelSet Set;
+	long long (*Sum)(const int *, size_t);
+	int (*Min)(const int *, size_t);
+	int (*Max)(const int *, size_t);
+	size_t (*Find)(const int *, size_t, int);
+	size_t (*CountInRange)(const int *, size_t, int, int);
+
+	void Use(KeyKernelSet set){
+		Set = set;
+		switch (set){
+			#ifdef KEY_KERNELS_X86
+			case AVX2Kernels:
+				Sum = SumAVX2; Min = MinAVX2; Max = MaxAVX2; Find = FindAVX2; CountInRange = CountInRangeAVX2;
+				break;
+			case SSE41Kernels:
+				Sum = SumSSE41; Min = MinSSE41; Max = MaxSSE41; Find = FindSSE41; CountInRange = CountInRangeSSE41;
+				break;
+			#endif
+			default:
+				Sum = SumPlain; Min = MinPlain; Max = MaxPlain; Find = FindPlain; CountInRange = CountInRangePlain;
+				break;
+		}
+	}
+};
+
+static Kernels &InUse(){
+	static Kernels kernels = []{		//Picked the first time a kernel is called
+		Kernels best;
+		best.Use(Supports(AVX2Kernels) ? AVX2Kernels : (Supports(SSE41Kernels) ? SSE41Kernels : PlainKernels));
+		return best;
+	}();
+	return kernels;
+}
+
+long long KeySum(const int *keys, size_t count){
+	return InUse().Sum(keys, count);
+}
+
+int KeyMin(const int *keys, size_t count){
+	return (count == 0) ? 0 : InUse().Min(keys, count);
+}
+
+int KeyMax(const int *keys, size_t count){
+	return (count == 0) ? 0 : InUse().Max(keys, count);
+}
+
+size_t KeyFind(const int *keys, size_t count, int key){
+	return InUse().Find(keys, count, key);
+}
+
+size_t KeyCountInRange(const int *keys, size_t count, int low, int high){
+	return InUse().CountInRange(keys, count, low, high);
+}
+
+KeyKernelSet KeyKernelsInUse(){
+	return InUse().Set;
+}
+
+bool UseKeyKernels(KeyKernelSet set){
+	if (!Supports(set)){
+		return false;
+	}
+	InUse().Use(set);
+	return true;
+}
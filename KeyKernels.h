@@ -0,0 +1,33 @@
+/*
+	Yong Wen Chua
+	http://bit.ly/yongwen
+	Released under the LGPL license
+*/
+/*
+	Kernels over a contiguous array of int keys, such as the number column of ColumnarList.
+
+	Each kernel has an AVX2, an SSE4.1 and a plain version. The best one the CPU supports is chosen the first time a
+	kernel is called, so the program runs on any x86 CPU (and on other CPUs, with the plain versions) without being
+	built for a particular one. The vector versions read 8 or 4 keys per instruction, so a scan runs at about the speed
+	memory can deliver the keys.
+*/
+//These Macros ensure that the file is only #included once.
+#pragma once
+#ifndef KeyKernels_H
+#define KeyKernels_H
+
+#include <cstddef>
+
+enum KeyKernelSet { PlainKernels, SSE41Kernels, AVX2Kernels };
+
+long long KeySum(const int *keys, size_t count);
+int KeyMin(const int *keys, size_t count);		//0 if count is 0
+int KeyMax(const int *keys, size_t count);		//0 if count is 0
+size_t KeyFind(const int *keys, size_t count, int key);		//Index of the first key equal to key. count if there is none
+size_t KeyCountInRange(const int *keys, size_t count, int low, int high);		//Number of keys from low to high, inclusive
+
+KeyKernelSet KeyKernelsInUse();
+//Use set instead of the best set the CPU supports, e.g. to compare them. Returns false if the CPU does not support it
+bool UseKeyKernels(KeyKernelSet set);
+
+#endif /* KeyKernels_H */
@@ -19,6 +19,17 @@
 			As TData is a generic type, the class will not know how to compare the parameters.
 			If TData is not a basic type, it should overload the == operator
 
+	Nodes are allocated through the allocator policy given as the second template parameter (see NodeAllocator.h).
+	By default, nodes are carved out of large slabs, which are only returned to the heap when the list is destroyed.
+	The third template parameter is a hash index policy (see HashIndex.h), used to search for and delete nodes by key.
+	By default, there is no hash index.
+	The fourth template parameter is an aggregate policy (see ListAggregates.h), which answers Sum(), Min() and Max().
+	By default, these walk the list.
+	The fifth and sixth template parameters are the key and comparison policies (see SortPolicies.h) that ordered methods
+	and Sort() order the nodes by. By default, nodes are ordered by the < operator on their int() value.
+	The seventh template parameter is an instrumentation policy (see Instrumentation.h), which is told about node allocations,
+	comparisons and walks along the list. By default, it does nothing.
+
 	LinkedList has some public "iteration" methods to allow the user to traverse the list.
 	E.g. Rewind(), Next(), Previous()
 
@@ -33,17 +44,82 @@
 #define List_H
 
 #include <new>
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <thread>
+#include <deque>
+#include <unordered_map>
+#include <type_traits>
 #include "ListNode.h"
+#include "NodeAllocator.h"
+#include "SkipListIndex.h"
+#include "HashIndex.h"
+#include "ListAggregates.h"
+#include "SortPolicies.h"
+#include "Instrumentation.h"
+#include "ListAlgorithms.h"
 
 //using namespace std;
 
-enum SortOrder { Unordered, Ascending, Descending };		//Sort order enumeration
-template <typename TData=int> class LinkedList{
+template <typename TData=int, typename TAllocator=SlabNodeAllocator<ListNode<TData> >, typename THashIndex=NoHashIndex<TData>, typename TAggregates=NoAggregates<TData>,
+	typename TKeyOf=IntKeyOf<TData>, typename TCompare=KeyLess, typename TInstrumentation=NoInstrumentation> class LinkedList{
+	friend struct ListAlgorithms;		//Batch inserts and deletes shared with DoublyLinkedList. See ListAlgorithms.h
+	typedef TInstrumentation _Instrumentation;
+	//Type of the keys the nodes are ordered by
+	typedef typename std::decay<decltype(std::declval<TKeyOf>()(std::declval<const TData &>()))>::type Key;
+	//The skip list index is kept on int() values, so it is only used with the default ordering
+	static const bool _IntKeyed = std::is_same<TKeyOf, IntKeyOf<TData> >::value && std::is_same<TCompare, KeyLess>::value;
+	//Integer keys in the default order can be radix sorted
+	typedef std::integral_constant<bool, std::is_integral<Key>::value && !std::is_same<Key, bool>::value && std::is_same<TCompare, KeyLess>::value> _RadixKeyed;
+
+	TAllocator _allocator;				//Node allocator. Every node of the list is allocated from here
 	ListNode<TData> *_firstNode;		//Pointer to the first node of the list
+	ListNode<TData> *_lastNode;			//Pointer to the last node of the list
+	int _length;						//Number of nodes in the list
 	ListNode<TData> *_current, *_previous;	//Current node, previous node.
 
-	//Sort Helper. Helps to compare and swap value. Used by Sort()
-	inline bool _SortHelper(ListNode<TData> *previous, ListNode<TData> *current, ListNode<TData> *next, SortOrder SortBy);
+	SkipListIndex<TData> _index;		//Index over the nodes while the list is ordered. See EnableIndex()
+	THashIndex _hashIndex;				//Index on a key of the nodes, used to search by key. See HashIndex.h
+	TAggregates _aggregates;			//Sum, minimum and maximum of the nodes. See ListAggregates.h
+	TKeyOf _keyOf;
+	TCompare _compare;
+	bool _indexEnabled;
+	int _sortThreads;					//Number of threads Sort() may use. See SetSortThreads()
+	int _parallelSortThreshold;			//Lists shorter than this are sorted on one thread
+	bool _IndexReady();		//Returns true if the index can be used, building it first if necessary
+
+	void _Recount();		//Walk the list to recompute _length and _lastNode. Used when a chain of nodes is attached as a whole
+	ListNode<TData> *_FindPrevious(ListNode<TData> *Node);		//Find the node before Node. Returns NULL if Node is not in the list
+	void _LinkAfter(ListNode<TData> *Node, ListNode<TData> *previous);		//Link Node after previous, or at the head if previous is NULL
+	void _Unlink(ListNode<TData> *Node, ListNode<TData> *previous);		//Unlink Node, which comes after previous. Node is not destroyed
+
+	//Sort Helpers. Used by Sort(), InsertNewNodeOrdered() and InsertOrderedBatch()
+	//Each is instantiated for Ascending and Descending order, and the public methods pick one by SortOrder.
+	//Compare two nodes. Returns true if node a has to be placed after node b in Order order (i.e. they are strictly out of order)
+	template <SortOrder Order> bool _SortHelper(ListNode<TData> *a, ListNode<TData> *b){
+		bool outOfOrder = SortDirection<Order>::Before(_compare, _keyOf(b -> Data()), _keyOf(a -> Data()));
+		TInstrumentation::Compared(outOfOrder);
+		return outOfOrder;
+	}
+	template <SortOrder Order> void _Sort();
+	template <SortOrder Order> void _InsertOrdered(ListNode<TData> *Node);
+	template <SortOrder Order> ListNode<TData> *_SortCutRun(ListNode<TData> *chain, ListNode<TData> *&tail, ListNode<TData> *&rest, bool normalise);
+	template <SortOrder Order> ListNode<TData> *_SortMerge(ListNode<TData> *a, ListNode<TData> *b, ListNode<TData> *&tail);
+	//Sorts a NULL terminated chain of length nodes and returns its first node. tail is set to the last node. Only touches
+	//the chain, so different chains can be sorted on different threads.
+	//Long chains with integer keys in the default order are radix sorted. The choice of sort is made at compile time by the last argument.
+	static const int RadixSortThreshold = 256;
+	template <SortOrder Order> ListNode<TData> *_SortChain(ListNode<TData> *chain, ListNode<TData> *&tail, int length){
+		return _SortChain<Order>(chain, tail, length, _RadixKeyed());
+	}
+	template <SortOrder Order> ListNode<TData> *_SortChain(ListNode<TData> *chain, ListNode<TData> *&tail, int length, std::true_type);
+	template <SortOrder Order> ListNode<TData> *_SortChain(ListNode<TData> *chain, ListNode<TData> *&tail, int length, std::false_type);
+	template <SortOrder Order> ListNode<TData> *_RadixSortChain(ListNode<TData> *chain, ListNode<TData> *&tail);
+	template <SortOrder Order> ListNode<TData> *_SortParallel(int threads);		//Sorts the list on threads threads. Returns the first node
+
+	//SearchForNode(), after the search is passed through SearchKey
+	template <typename TSearch> ListNode<TData> *_SearchForNode(TSearch search, ListNode<TData> *&previous);
 
 	public:
 
@@ -51,6 +127,11 @@ template <typename TData=int> class LinkedList{
 		LinkedList();								//Creates an empty list
 		LinkedList(ListNode<TData> *FirstNode);		//Create a list with an existing first node
 		LinkedList(TData data);						//Create a list with one element containing data
+		
+		/*
+			Data passed by value to the methods below is moved into the node, so passing an rvalue makes no copy.
+			The Emplace methods construct the data inside the node from their arguments, like the standard containers.
+		*/
 
 		//Destructor
 		~LinkedList();
@@ -59,7 +140,14 @@ template <typename TData=int> class LinkedList{
 			Retriving Methods
 		*/
 		ListNode<TData> *GetFirstNode();	//Get a pointer to the first node.
-		int Length();		//Returns the number of elements
+		ListNode<TData> *GetLastNode();		//Get a pointer to the last node.
+		int Length();		//Returns the number of elements. The count is kept up to date by every modifying method.
+
+		//Sum, minimum and maximum of the int() values of the nodes. Min() and Max() return 0 if the list is empty.
+		//Whether these walk the list or take constant time depends on the aggregate policy.
+		long long Sum(){ return _aggregates.Sum(_firstNode); }
+		int Min(){ return _aggregates.Min(_firstNode); }
+		int Max(){ return _aggregates.Max(_firstNode); }
 
 		/*
 			Iteration Methods
@@ -86,7 +174,10 @@ template <typename TData=int> class LinkedList{
 		//List Node data being used needs to overload the appropriate comparison operator for the different types of data it expects
 		//the user to use!
 		//If the second parameter is provided, a pointer to the previous node is provided
-		template <typename TSearch> ListNode<TData> *SearchForNode(TSearch search, ListNode<TData> *&previous);
+		//If the search starts from the first node and the hash index can answer it, the list is not walked at all.
+		template <typename TSearch> ListNode<TData> *SearchForNode(TSearch search, ListNode<TData> *&previous){
+			return _SearchForNode(SearchKey<TData>::Of(search), previous);
+		}
 		template <typename TSearch> ListNode<TData> *SearchForNode(TSearch search);
 
 		bool IsLast();		//Check if the internal pointer is pointing to the last item or past the last item
@@ -97,6 +188,7 @@ template <typename TData=int> class LinkedList{
 		*/
 
 		//Set the first node of the list to FirstNode. The node is not modified to point to the previous first node!
+		//The chain starting at FirstNode is walked to recount the list.
 		//After calling this method, SortStatus will be set to Unordered
 		void SetFirstNode(ListNode<TData> *FirstNode);
 		
@@ -105,6 +197,8 @@ template <typename TData=int> class LinkedList{
 		void InsertNewNode(ListNode<TData> *Node);		//Insert an already created Node
 		ListNode<TData> *InsertNewNode(TData data);		//Create a new node based on data. Returns a pointer to node.
 		ListNode<TData> *InsertNewNode();				//Create an empty new node. Returns a pointer to node.
+		//Construct the data of a new node in place from args. Returns a pointer to node.
+		template <typename... TArgs> ListNode<TData> *EmplaceNewNode(TArgs&&... args);
 		
 		/*
 			Insert a new node in an ordered manner. The order is determined by SortStatus.
@@ -114,6 +208,12 @@ template <typename TData=int> class LinkedList{
 		*/
 		void InsertNewNodeOrdered(ListNode<TData> *Node);		//Insert an already created Node
 		ListNode<TData> *InsertNewNodeOrdered(TData data);		//Create a new node based on data. Returns a pointer to node.
+		template <typename... TArgs> ListNode<TData> *EmplaceNewNodeOrdered(TArgs&&... args);		//Construct the data in place
+		//Insert the records in [first, last) as if InsertNewNodeOrdered() was called for each of them in turn. The records are
+		//copied, or moved out of the range if the iterators are std::move_iterators (see std::make_move_iterator()).
+		//The batch is sorted and merged into the list in one pass, in O(n + m log m) time.
+		template <typename TIterator> void InsertOrderedBatch(TIterator first, TIterator last);
+		void InsertOrderedBatch(std::vector<ListNode<TData> *> batch);		//Insert a batch of already created nodes, in the order of the vector
 	
 		/*
 			Search the list for data corresponding to the data and deletes the first n instances of it. Returns the number of items deleted
@@ -121,15 +221,40 @@ template <typename TData=int> class LinkedList{
 
 			Note: TData must be able to handle the appropriate overloaded == operator. This is because this class
 			has no means of determining the type or structure of TData.
+			If the hash index can answer searches of type TSearch, the matching nodes are found through it instead.
 
 			Causes Rewind() to be called.
 		*/
-		template <typename TSearch> int DeleteNode(TSearch data, int n = -1);
-		//This method simply deletes the node provided to it and does the relinking if the previous node was provided
+		template <typename TSearch> int DeleteNode(TSearch data, int n = -1){
+			return ListAlgorithms::DeleteNode(*this, SearchKey<TData>::Of(data), n);
+		}
+		/*
+			For each i, deletes the first counts[i] nodes matching keys[i] (all of them if counts[i] is -1), as if DeleteNode()
+			was called for each key in turn. The number of nodes deleted for each key is put in deleted[i]. Returns the total.
+
+			If the hash index can answer searches for the keys, each key is deleted through it. Otherwise the list is walked
+			once, and the key of each node, as returned by keyOf(TData &), is looked up among the keys in a hash table.
+			Without keyOf, the keys are int() values.
+
+			Causes Rewind() to be called.
+		*/
+		template <typename TSearch, typename TSearchOf> int DeleteNodesBatch(const std::vector<TSearch> &keys, const std::vector<int> &counts, std::vector<int> &deleted, TSearchOf keyOf){
+			return ListAlgorithms::DeleteNodesBatch(*this, keys, counts, deleted, keyOf);
+		}
+		int DeleteNodesBatch(const std::vector<int> &keys, const std::vector<int> &counts, std::vector<int> &deleted);
+		//This method simply deletes the node provided to it and does the relinking.
+		//If the previous node is not provided, the list is searched for it.
 		//THIS VERSION OF THE METHOD IS POTENTIALLY UNSAFE (i.e. MEMORY LEAK IS POSSIBLE)
 		void DeleteNode(ListNode<TData> *Node, ListNode<TData> *previous = NULL);	
+		void Clear();		//Destroy every node. The list is left empty and Unordered, as it was constructed
 		
-		//Append after the node provided in an unordered manner. Beware of memory leak. Sets SortStatus to Unordered
+		//Append a node at the end of the list, in constant time. Sets SortStatus to Unordered
+		void PushBack(ListNode<TData> *Node);			//Append an already created Node
+		ListNode<TData> *PushBack(TData data);			//Create a new node based on data. Returns a pointer to node.
+		template <typename... TArgs> ListNode<TData> *EmplaceBack(TArgs&&... args);		//Construct the data in place
+
+		//Append after the node provided in an unordered manner. Any nodes after Node are cut off from the list.
+		//Beware of memory leak. Sets SortStatus to Unordered
 		//THESE METHODS ARE POTENTIALLY UNSAFE (i.e. MEMORY LEAK IS POSSIBLE)
 		void AppendNode(ListNode<TData> *Node, ListNode<TData> *NewNode);		//Append an already created Node
 		ListNode<TData> *AppendNode(ListNode<TData> *Node, TData data);		//Create a new node based on data. Returns a pointer to node.
@@ -139,8 +264,9 @@ template <typename TData=int> class LinkedList{
 		void InsertNodeAfter(ListNode<TData> *RefNode, ListNode<TData> *NewNode);
 		ListNode<TData> *InsertNodeAfter(ListNode<TData> *RefNode, TData NewData);
 		ListNode<TData> *InsertNodeAfter(ListNode<TData> *RefNode);
+		template <typename... TArgs> ListNode<TData> *EmplaceNodeAfter(ListNode<TData> *RefNode, TArgs&&... args);
 
-		//Delete everything down the chain. Remember to set the pointer of the previous item to NULL or provide the pointer.
+		//Delete everything down the chain. Provide the pointer to the previous item if it is known, otherwise the list is searched for it.
 		//Calls Rewind()
 		//THIS VERSION OF THE METHOD IS POTENTIALLY UNSAFE (i.e. MEMORY LEAK IS POSSIBLE)
 		void DeleteNodesChained(ListNode<TData> *Node, ListNode<TData> *previous=NULL);
@@ -157,23 +283,43 @@ template <typename TData=int> class LinkedList{
 		*/
 		void Reverse();				//Reverse the list. Implicitly calls Rewind() Changes SortStatus
 		SortOrder GetSortStatus(){ return _SortStatus; }
+		//Declare that the list is already in SortBy order, without sorting it. The caller must make sure that it is.
+		//Used when a list that was saved in order is loaded back.
+		void SetSortStatus(SortOrder SortBy);
+
+		/*
+			Index Related
+		*/
+		//Keep a skip list index (see SkipListIndex.h) over the list while it is ordered. The index is built the first time
+		//it is needed after the list is sorted or reversed, and is dropped whenever SortStatus becomes Unordered.
+		//While it is in use, InsertNewNodeOrdered(), SeekNumber() and SeekPosition() take expected O(log n) time.
+		//The index is kept on int() values, so it is only used when the list is ordered by the default key and comparison.
+		void EnableIndex(bool enable = true);
+		ListNode<TData> *SeekNumber(int number);		//Returns the first node whose int() value is number. NULL if there is none
+		ListNode<TData> *SeekPosition(int position);	//Returns the node at position, counting from 0. NULL if out of range
 		
-		//	Apply bubble sort algorithmn. Implicitly calls Rewind(). Changes SortStatus
+		//	Apply a stable natural merge sort, O(n log n). Implicitly calls Rewind(). Changes SortStatus
 		void Sort(SortOrder SortBy = Ascending);	
+		//Lets Sort() split lists of at least threshold nodes into segments, sort them on up to threads threads and merge
+		//them back in parallel. The result is the same as on one thread. threads of 0 uses one per hardware thread and
+		//1 always sorts on the calling thread. By default, lists of 65536 nodes or more are sorted on every hardware thread.
+		void SetSortThreads(int threads, int threshold = 65536);
 
 		/*
-			Static Methods
+			Node Factory Methods
 		*/
 
-		//Node Factory Methods - returns pointer to new node.
+		//Node Factory Methods - returns pointer to new node, allocated from the list's allocator.
+		//Nodes passed to the list must come from the same list's CreateNode(), because they are returned to its allocator.
 		//Be careful of memory leaks if you use these methods!
 		//THIS METHOD IS POTENTIALLY UNSAFE! USUALLY, YOU DO NOT NEED TO CALL THIS AT ALL!
-		static ListNode<TData> *CreateNode();
-		static ListNode<TData> *CreateNode(TData data);
+		ListNode<TData> *CreateNode();
+		ListNode<TData> *CreateNode(TData data);
+		template <typename... TArgs> ListNode<TData> *EmplaceNode(TArgs&&... args);		//Construct the data in place from args
 
-		//Destroy node
+		//Destroy node and return its memory to the list's allocator
 		//THIS METHOD IS POTENTIALLY UNSAFE! USUALLY, YOU DO NOT NEED TO CALL THIS AT ALL!
-		static void DestroyNode(ListNode<TData> *Node);
+		void DestroyNode(ListNode<TData> *Node);
 
 	protected:
 		SortOrder _SortStatus;			//Stores the sort status of the list
@@ -183,36 +329,54 @@ template <typename TData=int> class LinkedList{
 /*
 	Constructor
 */
-template <typename TData> LinkedList<TData>::LinkedList(){		//Set everything to be empty
-	_firstNode = NULL;
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::LinkedList(){		//Set everything to be empty
+	_firstNode = _lastNode = NULL;
+	_length = 0;
+	_indexEnabled = false;
+	SetSortThreads(0);
 	_SortStatus = Unordered;
 	Rewind();
 }
 
 
-template <typename TData> LinkedList<TData>::LinkedList(ListNode<TData> *FirstNode){
-	InsertNewNode(FirstNode);	//Set first node as the node provided
-	_SortStatus = Unordered;
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::LinkedList(ListNode<TData> *FirstNode){
+	_firstNode = _lastNode = NULL;
+	_length = 0;
+	_indexEnabled = false;
+	SetSortThreads(0);
+	SetFirstNode(FirstNode);	//Set first node as the node provided
 	Rewind();
 }
 
-template <typename TData> LinkedList<TData>::LinkedList(TData data){
-	InsertNewNode(data);		//Create a new node based on data provided.
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::LinkedList(TData data){
+	_firstNode = _lastNode = NULL;
+	_length = 0;
+	_indexEnabled = false;
+	SetSortThreads(0);
+	InsertNewNode(std::move(data));		//Create a new node based on data provided.
 	_SortStatus = Unordered;
+	Rewind();
 }
 
 
 /*
 	Destructor
 */
-template <typename TData> LinkedList<TData>::~LinkedList(){
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::~LinkedList(){
 	//std::cout << "Destroying List" << std::endl;
-	//Traverse the list and delete! This is because new nodes are created with the new keyword and needs to be deleted to prevent leaks!
+	//Traverse the list and destroy every node. If the allocator releases all its memory at once when it is destroyed,
+	//the memory of each node need not be given back one at a time.
 	ListNode<TData> *current, *next;
 	current = _firstNode;
 	while (current != NULL){
 		next = current -> Next();
-		DestroyNode(current);		//Destroy the node
+		if (TAllocator::ReleasesAll){
+			TInstrumentation::Freed();
+			current -> ~ListNode<TData>();
+		}
+		else{
+			DestroyNode(current);		//Destroy the node
+		}
 		current = next;
 	}
 }
@@ -221,16 +385,17 @@ template <typename TData> LinkedList<TData>::~LinkedList(){
 	Iteration Methods
 */
 //Rewind()
-template <typename TData> void LinkedList<TData>::Rewind(){
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> void LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::Rewind(){
+	TInstrumentation::Rewound();
 	_current = _firstNode;
 	_previous = NULL;
 }
 //IsFirst()
-template <typename TData> bool LinkedList<TData>::IsFirst(){
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> bool LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::IsFirst(){
 	return (_current == _firstNode);
 }
 //IsLast()
-template <typename TData> bool LinkedList<TData>::IsLast(){
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> bool LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::IsLast(){
 	if (_current == NULL){
 		return true;
 	}
@@ -239,14 +404,14 @@ template <typename TData> bool LinkedList<TData>::IsLast(){
 	}
 }
 //Previous()
-template <typename TData> ListNode<TData> *LinkedList<TData>::Previous(){
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> ListNode<TData> *LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::Previous(){
 	if (IsFirst()){
 		return NULL;
 	}
 	return _previous;
 }
 //Next()
-template <typename TData> ListNode<TData> *LinkedList<TData>::Next(){
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> ListNode<TData> *LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::Next(){
 	if (_current == NULL){
 		return NULL;
 	}
@@ -256,7 +421,7 @@ template <typename TData> ListNode<TData> *LinkedList<TData>::Next(){
 	return Current();
 }
 //Current()
-template <typename TData> ListNode<TData> *LinkedList<TData>::Current(){
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> ListNode<TData> *LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::Current(){
 	return _current;
 }
 
@@ -264,10 +429,12 @@ template <typename TData> ListNode<TData> *LinkedList<TData>::Current(){
 //Template TSearch is used to allow for flexibility in the list node data type used.
 //List Node data being used needs to overload the appropriate comparison operator for the different types of data it expects
 //the user to use!
-template <typename TData> template <typename TSearch> ListNode<TData> *LinkedList<TData>::SearchForNode(TSearch search, ListNode<TData> *&previous){
-	if (Current()->Data() == search){
-		previous = Previous();
-		return Current();
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> template <typename TSearch> ListNode<TData> *LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::_SearchForNode(TSearch search, ListNode<TData> *&previous){
+	ListNode<TData> *node;
+	if (IsFirst() && _hashIndex.Find(search, _firstNode, node, previous)){		//Searching from the start. Ask the hash index
+		_current = node;
+		_previous = (node == NULL) ? _lastNode : previous;
+		return node;
 	}
 	while (Current() != NULL){
 		if (Current()->Data() == search){
@@ -275,12 +442,13 @@ template <typename TData> template <typename TSearch> ListNode<TData> *LinkedLis
 			return Current();
 		}
 		Next();
+		TInstrumentation::Stepped();
 		
 	}
 	return NULL;
 }
 //Since we cannot set a default value for a reference variable, we have to resort to using a dummy variable
-template <typename TData> template <typename TSearch> ListNode<TData> *LinkedList<TData>::SearchForNode(TSearch search){
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> template <typename TSearch> ListNode<TData> *LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::SearchForNode(TSearch search){
 	ListNode<TData> *dummy;
 	return SearchForNode(search, dummy);		//dummy is discarded by the time this method returns.
 }
@@ -288,112 +456,200 @@ template <typename TData> template <typename TSearch> ListNode<TData> *LinkedLis
 	Retrieving methods
 */
 //GetFirstNode()
-template <typename TData> ListNode<TData> *LinkedList<TData>::GetFirstNode(){
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> ListNode<TData> *LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::GetFirstNode(){
 	return _firstNode;
 }
 
+//GetLastNode()
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> ListNode<TData> *LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::GetLastNode(){
+	return _lastNode;
+}
+
 //Length()
-template <typename TData> int LinkedList<TData>::Length(){
-	if (_firstNode == NULL){
-		return 0;
-	}
-	else if(_firstNode -> Next() == NULL){
-		return 1;
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> int LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::Length(){
+	return _length;
+}
+
+//_Recount()
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> void LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::_Recount(){
+	_length = 0;
+	_lastNode = NULL;
+	ListNode<TData> *current = _firstNode;
+	while (current != NULL){
+		_length++;
+		_lastNode = current;
+		current = current -> Next();
 	}
-	else{
-		int count = 0;
-		ListNode<TData> *current;
-		current = _firstNode;
-		while (current != NULL){
-			count ++;
+}
 
-			current = current -> Next();
-		}
-		return count;
+//_FindPrevious()
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> ListNode<TData> *LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::_FindPrevious(ListNode<TData> *Node){
+	ListNode<TData> *current = _firstNode;
+	while (current != NULL && current -> Next() != Node){
+		current = current -> Next();
 	}
+	return current;
 }
 
 /*
 	Modification Methods
 */
+//_LinkAfter()
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> void LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::_LinkAfter(ListNode<TData> *Node, ListNode<TData> *previous){
+	if (previous == NULL){
+		Node -> SetNext(_firstNode);
+		_firstNode = Node;
+	}
+	else{
+		Node -> SetNext(previous -> Next());
+		previous -> SetNext(Node);
+	}
+	if (Node -> Next() == NULL){
+		_lastNode = Node;
+	}
+	_length++;
+	_hashIndex.Linked(Node, previous);
+	_aggregates.Added(Node);
+}
+//_Unlink()
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> void LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::_Unlink(ListNode<TData> *Node, ListNode<TData> *previous){
+	_hashIndex.Unlinked(Node, previous);
+	_aggregates.Removed(Node);
+	if (_index.IsBuilt()){
+		_index.Remove(Node);
+	}
+	if (previous == NULL){
+		_firstNode = Node -> Next();
+	}
+	else{
+		previous -> SetNext(Node -> Next());
+	}
+	if (Node == _lastNode){
+		_lastNode = previous;
+	}
+	_length--;
+}
+
 //SetFirstNode()
-template <typename TData> void LinkedList<TData>::SetFirstNode(ListNode<TData> *FirstNode){
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> void LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::SetFirstNode(ListNode<TData> *FirstNode){
 	_firstNode = FirstNode;
 	_SortStatus = Unordered;
+	_index.Clear();
+	_hashIndex.Reset();
+	_aggregates.Reset();
+	_Recount();
 }
 
 //InsertNewNode()
-template <typename TData> void LinkedList<TData>::InsertNewNode(ListNode<TData> *Node){
-	Node -> SetNext(_firstNode);
-	SetFirstNode(Node);
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> void LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::InsertNewNode(ListNode<TData> *Node){
+	_LinkAfter(Node, NULL);
+	_SortStatus = Unordered;
+	_index.Clear();
 }
-template <typename TData> ListNode<TData> *LinkedList<TData>::InsertNewNode(TData data){
-	ListNode<TData> *Node = CreateNode();			//Create a new node based on data provided
-	Node -> SetNext(_firstNode);
-	Node -> SetData(data);
-	SetFirstNode(Node);
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> ListNode<TData> *LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::InsertNewNode(TData data){
+	ListNode<TData> *Node = CreateNode(std::move(data));			//Create a new node based on data provided
+	InsertNewNode(Node);
 
 	return Node;
 }
-template <typename TData> ListNode<TData> *LinkedList<TData>::InsertNewNode(){
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> template <typename... TArgs> ListNode<TData> *LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::EmplaceNewNode(TArgs&&... args){
+	ListNode<TData> *Node = EmplaceNode(std::forward<TArgs>(args)...);
+	InsertNewNode(Node);
+	return Node;
+}
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> ListNode<TData> *LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::InsertNewNode(){
 	ListNode<TData> *Node = CreateNode();			//Create an empty new node.
-	Node -> SetNext(_firstNode);
-	SetFirstNode(Node);
+	InsertNewNode(Node);
+
+	return Node;
+}
 
+//PushBack()
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> void LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::PushBack(ListNode<TData> *Node){
+	_LinkAfter(Node, _lastNode);
+	_SortStatus = Unordered;
+	_index.Clear();
+}
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> ListNode<TData> *LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::PushBack(TData data){
+	ListNode<TData> *Node = CreateNode(std::move(data));
+	PushBack(Node);
+	return Node;
+}
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> template <typename... TArgs> ListNode<TData> *LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::EmplaceBack(TArgs&&... args){
+	ListNode<TData> *Node = EmplaceNode(std::forward<TArgs>(args)...);
+	PushBack(Node);
 	return Node;
 }
 
 //InsertNewNodeOrdered()
-template <typename TData> void LinkedList<TData>::InsertNewNodeOrdered(ListNode<TData> *Node){
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> void LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::InsertNewNodeOrdered(ListNode<TData> *Node){
 	if (_SortStatus == Unordered){
 		return InsertNewNode(Node);			//Unordered? Just add the node to the head of the list!
 	}
-	ListNode<TData> *current, *previous;
-
-	if (_firstNode == NULL){	//No Nodes
-		_firstNode = Node;
+	if (_IndexReady()){			//Let the index find the node to insert after
+		_LinkAfter(Node, _index.Insert(Node));
+		return;
+	}
+	if (_SortStatus == Ascending){
+		_InsertOrdered<Ascending>(Node);
 	}
 	else{
-		current = _firstNode;
-		previous = NULL;
-		while (current != NULL){		//Search for node
-			if ( 
-				(_SortStatus == Ascending && ((int) current -> Data() >= (int) Node -> Data()))
-				||
-				(_SortStatus == Descending && ((int) current -> Data() <= (int) Node -> Data()))
-				){		//Matched!
-				Node -> SetNext(current);
-				if (previous == NULL){
-					_firstNode = Node;
-				}
-				else{
-					previous -> SetNext(Node);
-				}
-				return;			//Now that the node has been inserted, we can return the method
-			}
-			else{
-				previous = current;
-				current = previous -> Next();
-			}
-		}
-		//If this point is ever reached, the node to insert is either the largest (ASC) or the smallest (DSC)
-		//Then let's append it to the back
-		previous -> SetNext(Node);
+		_InsertOrdered<Descending>(Node);
+	}
+}
+//Helper method. Search for the first node that Node does not have to be placed after in Order order. The node is inserted before it.
+//If there is none, the node to insert is either the largest (ASC) or the smallest (DSC), and is appended to the back
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> template <SortOrder Order> void LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::_InsertOrdered(ListNode<TData> *Node){
+	ListNode<TData> *current = _firstNode, *previous = NULL;
+	while (current != NULL && _SortHelper<Order>(Node, current)){
+		TInstrumentation::Stepped();
+		previous = current;
+		current = previous -> Next();
 	}
+	_LinkAfter(Node, previous);
 }
 
-template <typename TData> ListNode<TData> *LinkedList<TData>::InsertNewNodeOrdered(TData data){
-	ListNode<TData> *Node = CreateNode();			//Create a new node based on data to insert.
-	Node -> SetData(data);
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> ListNode<TData> *LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::InsertNewNodeOrdered(TData data){
+	ListNode<TData> *Node = CreateNode(std::move(data));			//Create a new node based on data to insert.
+	InsertNewNodeOrdered(Node);
+	return Node;
+}
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> template <typename... TArgs> ListNode<TData> *LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::EmplaceNewNodeOrdered(TArgs&&... args){
+	ListNode<TData> *Node = EmplaceNode(std::forward<TArgs>(args)...);
 	InsertNewNodeOrdered(Node);
 	return Node;
 }
 
+//InsertOrderedBatch()
+//Inserting one record at a time puts each record before the records with the same key inserted before it, and before the
+//nodes with the same key already in the list. So the batch is reversed, then sorted stably, and each node of the batch
+//goes before the first node of the list it has to be inserted before, as InsertNewNodeOrdered() would do. The merge is
+//shared with DoublyLinkedList (see ListAlgorithms::InsertOrderedBatch()).
+//If the skip index is in use and the batch is small, inserting one record at a time through it is cheaper than a walk.
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> template <typename TIterator> void LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::InsertOrderedBatch(TIterator first, TIterator last){
+	std::vector<ListNode<TData> *> batch;
+	for (; first != last; ++first){
+		batch.push_back(CreateNode(*first));
+	}
+	InsertOrderedBatch(std::move(batch));
+}
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> void LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::InsertOrderedBatch(std::vector<ListNode<TData> *> batch){
+	if (_SortStatus == Unordered || (_indexEnabled && _IntKeyed && batch.size() * 16 < (size_t) _length)){
+		for (size_t i = 0; i < batch.size(); i++){
+			InsertNewNodeOrdered(batch[i]);
+		}
+		return;
+	}
+	ListAlgorithms::InsertOrderedBatch(*this, batch);
+	_index.Clear();			//Rebuilt when it is next needed
+}
 //Sort()
-//The sort method works by this: It runs through the list once first to find the length of the list
-//Along the way, swap items as necessary.
-//Then do the normal sorting.
-template <typename TData> void LinkedList<TData>::Sort(SortOrder SortBy){
+//The sort method is a bottom-up natural merge sort. Nodes are only relinked, never copied, and no extra memory is used.
+//Each pass cuts the list into runs that are already in order and merges them pairwise, until only one run is left.
+//On the first pass, runs that are strictly in the opposite order are reversed in place, so a list that is nearly
+//sorted (or sorted the other way round) is sorted in close to linear time. Equal items keep their relative order.
+//Lists of RadixSortThreshold nodes or more with integer keys in the default order are radix sorted instead, in linear time.
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> void LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::Sort(SortOrder SortBy){
 	if (SortBy == Unordered){
 		return;
 	}
@@ -403,134 +659,232 @@ template <typename TData> void LinkedList<TData>::Sort(SortOrder SortBy){
 	if (_firstNode -> Next() == NULL){		//1 Item?
 		return;
 	}
-	int length = 0;
-	ListNode<TData> *previous, *current, *next;
-	previous = NULL;
-	current = _firstNode;
-	bool swapped = false;
-	next = current -> Next();
-	//Traverse the list once first to find the length
-	while (current != NULL){
-		//cout << "Previous: " << (previous == NULL ? -1 :  (int) previous -> Data() ) << "\t";
-		//cout << "Current: " << (current == NULL ? -1 : int(current -> Data())) << "\t";
-		//cout << "Next: " << (next == NULL ? -1 : int(next -> Data())) << "\t";
-		bool _swapped = _SortHelper(previous, current, next, SortBy);
-		if (_swapped){		//Next is not NULL
-			swapped = true;
-			length++;
-			previous = next;
-			next = current -> Next();
-			//cout << "Swapped\t";
-		}
-		else{		//No swapping was done. Next could be NULL.
-			length++;
-			previous = current;
-			current = current -> Next();
-			if (current == NULL){
-				break;
+	if (SortBy == Ascending){
+		_Sort<Ascending>();
+	}
+	else{
+		_Sort<Descending>();
+	}
+	_SortStatus = SortBy;
+	_index.Clear();			//Rebuilt when it is next needed
+	_hashIndex.Reset();
+	Rewind();
+}
+//Helper method. Sorts the list in Order order
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> template <SortOrder Order> void LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::_Sort(){
+	int threads = (_length >= _parallelSortThreshold) ? _sortThreads : 1;
+	if (threads > 1){
+		_firstNode = _SortParallel<Order>(threads);
+	}
+	else{
+		_firstNode = _SortChain<Order>(_firstNode, _lastNode, _length);
+	}
+}
+//Helper method. Radix sorts long chains with integer keys, and merge sorts the rest
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> template <SortOrder Order> ListNode<TData> *LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::_SortChain(ListNode<TData> *chain, ListNode<TData> *&tail, int length, std::true_type){
+	if (length >= RadixSortThreshold){
+		return _RadixSortChain<Order>(chain, tail);
+	}
+	return _SortChain<Order>(chain, tail, length, std::false_type());
+}
+//Helper method. An LSD radix sort on the integer keys of the nodes, in O(n) time.
+//Each pass deals the nodes into 256 buckets by one byte of the key, least significant byte first, and chains the buckets
+//back together. Dealing keeps the order of the nodes within a bucket, so every pass is stable and so is the sort.
+//The sign bit of signed keys is flipped so that negative keys come first, and for a descending sort all bits are flipped.
+//Passes over bytes that are the same in every key are skipped.
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> template <SortOrder Order> ListNode<TData> *LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::_RadixSortChain(ListNode<TData> *chain, ListNode<TData> *&tail){
+	typedef typename std::make_unsigned<Key>::type Bits;
+	const int width = (int) sizeof(Bits) * 8;
+	Bits sign = std::is_signed<Key>::value ? (Bits) ((Bits) 1 << (width - 1)) : (Bits) 0;
+	Bits flip = (Order == Ascending) ? sign : (Bits) ~sign;
+	ListNode<TData> *heads[256], *tails[256], *node;
+	Bits first = (Bits) _keyOf(chain -> Data()), differ = 0;
+	for (node = chain; node != NULL; node = node -> Next()){
+		differ |= (Bits) _keyOf(node -> Data()) ^ first;
+	}
+	tail = chain;
+	for (int shift = 0; shift < width; shift += 8){
+		if (((differ >> shift) & 0xFF) == 0){
+			continue;
+		}
+		for (int i = 0; i < 256; i++){
+			heads[i] = NULL;
+		}
+		for (node = chain; node != NULL; node = node -> Next()){
+			unsigned int bucket = (unsigned int) ((((Bits) _keyOf(node -> Data()) ^ flip) >> shift) & 0xFF);
+			if (heads[bucket] == NULL){
+				heads[bucket] = node;
 			}
-			next = current -> Next();
-			//cout << "Not Swapped\t";
+			else{
+				tails[bucket] -> SetNext(node);
+			}
+			tails[bucket] = node;
 		}
-		//cout << "Length: " << length << endl;
-	}
-
-
-	//Debugging Purposes
-	//current = _firstNode;
-	//cout << endl << "0 Pass --> Length: " << length << "\t";
-	//for (int j = 0; j < length; j++){
-	//	cout << (int) current->Data() << " ";
-	//	current = current -> Next();
-	//}
-	//cout <<endl;
-	//End Debugging
-
-	//Now that we have found the length, the usual sorting can take place
-	if (swapped){
-		for (int i = 1; i < length; i++){
-			swapped = false;
-			previous = NULL;
-			current = _firstNode;
-			next = current -> Next();
-			//By the ith time the list is traversed, the last i items will already be in place.
-			//So we don't have to traverse the whole list again.
-			for (int j = 0; j < length-i; j++){			
-				//cout << "Previous: " << (previous == NULL ? -1 :  (int) previous -> Data() ) << "\t";
-				//cout << "Current: " << (current == NULL ? -1 : int(current -> Data())) << "\t";
-				//cout << "Next: " << (next == NULL ? -1 : int(next -> Data())) << "\t";
-				bool _swapped = _SortHelper(previous, current, next, SortBy);
-				if (_swapped){		//Next is not NULL
-					swapped = true;
-					previous = next;
-					next = current -> Next();
-					//cout << "Swapped\t";
-				}
-				else{		//No swapping was done. Next could be NULL.
-					previous = current;
-					current = current -> Next();
-					if (current == NULL){
-						break;
-					}
-					next = current -> Next();
-					//cout << "Not Swapped\t";
-				}
-				//cout << "Length: " << length << endl;
+		chain = tail = NULL;
+		for (int i = 0; i < 256; i++){
+			if (heads[i] == NULL){
+				continue;
 			}
-
-			//Debugging Purposes
-			//current = _firstNode;
-			//cout << i << " Pass --> Length: " << length << "\t";
-			//for (int j = 0; j < length; j++){
-			//	cout << (int) current->Data() << " ";
-			//	current = current -> Next();
-			//}
-			//cout <<endl;
-			
-			//End Debugging
-
-			if (swapped == false){
-				break;
+			if (chain == NULL){
+				chain = heads[i];
 			}
+			else{
+				tail -> SetNext(heads[i]);
+			}
+			tail = tails[i];
 		}
+		tail -> SetNext(NULL);
 	}
-	_SortStatus = SortBy;
-	Rewind();
+	if (differ == 0){		//All keys are equal, so the chain is already sorted. Find its end
+		while (tail -> Next() != NULL){
+			tail = tail -> Next();
+		}
+	}
+	return chain;
 }
-//Helper method. To compare and then swap if necessary.
-template <typename TData> inline bool LinkedList<TData>::_SortHelper(ListNode<TData> *previous, ListNode<TData> *current, ListNode<TData> *next, SortOrder SortBy){
-	if (next == NULL){
-		return false;
+//Helper method. The natural merge sort described above, on a chain of nodes
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> template <SortOrder Order> ListNode<TData> *LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::_SortChain(ListNode<TData> *chain, ListNode<TData> *&tail, int, std::false_type){
+	ListNode<TData> *head, *rest, *run, *runTail, *other, *otherTail;
+	bool normalise = true;		//Only look for reversed runs on the first pass
+	int runs;
+	do{
+		head = tail = NULL;
+		rest = chain;
+		runs = 0;
+		while (rest != NULL){
+			run = _SortCutRun<Order>(rest, runTail, rest, normalise);
+			if (rest != NULL){		//Merge with the next run, if there is one
+				other = _SortCutRun<Order>(rest, otherTail, rest, normalise);
+				run = _SortMerge<Order>(run, other, runTail);
+			}
+			if (head == NULL){
+				head = run;
+			}
+			else{
+				tail -> SetNext(run);
+			}
+			tail = runTail;
+			runs++;
+		}
+		chain = head;
+		normalise = false;
+	} while (runs > 1);
+	return head;
+}
+//Helper method. Cuts the list into one segment per thread in a single pass, and sorts each segment on its own thread.
+//Neighbouring segments are then merged pairwise, each pair on its own thread, until one is left. Since segments are only
+//merged with their neighbours, with the earlier one first on ties, the sort stays stable.
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> template <SortOrder Order> ListNode<TData> *LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::_SortParallel(int threads){
+	std::vector<ListNode<TData> *> heads, tails;
+	int size = (_length + threads - 1) / threads;
+	ListNode<TData> *node = _firstNode, *next;
+	while (node != NULL){
+		heads.push_back(node);
+		for (int i = 1; i < size && node -> Next() != NULL; i++){
+			node = node -> Next();
+		}
+		next = node -> Next();
+		node -> SetNext(NULL);
+		node = next;
 	}
-	if ( 
-		(SortBy == Ascending && ((int) current->Data() > (int) next->Data()))
-		||
-		(SortBy == Descending && ((int) current->Data() < (int) next->Data()))
-		){
-		
-		if (current == _firstNode){
-			_firstNode = next;
+	int segments = (int) heads.size();
+	tails.resize(segments);
+	std::vector<std::thread> workers;
+	for (int i = 1; i < segments; i++){
+		workers.push_back(std::thread([this, &heads, &tails, i, size]{ heads[i] = this -> template _SortChain<Order>(heads[i], tails[i], size); }));
+	}
+	heads[0] = _SortChain<Order>(heads[0], tails[0], size);		//The calling thread takes the first segment
+	for (size_t i = 0; i < workers.size(); i++){
+		workers[i].join();
+	}
+	for (int step = 1; step < segments; step *= 2){		//Merge segment i with segment i + step
+		workers.clear();
+		for (int i = 2 * step; i + step < segments; i += 2 * step){
+			workers.push_back(std::thread([this, &heads, &tails, i, step]{
+				heads[i] = this -> template _SortMerge<Order>(heads[i], heads[i + step], tails[i]);
+			}));
 		}
-		else{
-			previous -> SetNext(next);
+		heads[0] = _SortMerge<Order>(heads[0], heads[step], tails[0]);
+		for (size_t i = 0; i < workers.size(); i++){
+			workers[i].join();
+		}
+	}
+	_lastNode = tails[0];
+	return heads[0];
+}
+//Helper method. Detaches the run at the front of chain that is already in Order order and returns its first node.
+//If normalise is set, a run that is strictly in the opposite order is detected too, and is reversed in place.
+//tail is set to the last node of the run (which is terminated with NULL) and rest to the remainder of the chain.
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> template <SortOrder Order> ListNode<TData> *LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::_SortCutRun(ListNode<TData> *chain, ListNode<TData> *&tail, ListNode<TData> *&rest, bool normalise){
+	ListNode<TData> *current = chain -> Next(), *next;
+	tail = chain;
+	if (normalise && current != NULL && _SortHelper<Order>(chain, current)){		//Reversed run
+		chain -> SetNext(NULL);
+		while (current != NULL && _SortHelper<Order>(chain, current)){
+			next = current -> Next();
+			current -> SetNext(chain);
+			chain = current;
+			current = next;
 		}
-		if (next -> Next() == NULL){
-			current -> SetNext(NULL);
+		rest = current;
+		return chain;
+	}
+	while (current != NULL && !_SortHelper<Order>(tail, current)){
+		tail = current;
+		current = current -> Next();
+	}
+	tail -> SetNext(NULL);
+	rest = current;
+	return chain;
+}
+//Helper method. Merges two NULL terminated runs and returns the first node. tail is set to the last node.
+//On ties, nodes from a are taken first so that the sort is stable.
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> template <SortOrder Order> ListNode<TData> *LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::_SortMerge(ListNode<TData> *a, ListNode<TData> *b, ListNode<TData> *&tail){
+	ListNode<TData> *head;
+	if (_SortHelper<Order>(a, b)){
+		head = tail = b;
+		b = b -> Next();
+	}
+	else{
+		head = tail = a;
+		a = a -> Next();
+	}
+	while (a != NULL && b != NULL){
+		if (_SortHelper<Order>(a, b)){
+			tail -> SetNext(b);
+			tail = b;
+			b = b -> Next();
 		}
 		else{
-			current -> SetNext(next -> Next());
+			tail -> SetNext(a);
+			tail = a;
+			a = a -> Next();
 		}
-		next -> SetNext(current);
-
-		return true;
 	}
-	else{
-		return false;
+	tail -> SetNext(a != NULL ? a : b);		//Append whatever is left and walk to its end
+	while (tail -> Next() != NULL){
+		tail = tail -> Next();
 	}
+	return head;
+}
+
+//SetSortThreads()
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> void LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::SetSortThreads(int threads, int threshold){
+	if (threads <= 0){
+		threads = (int) std::thread::hardware_concurrency();		//0 if it cannot be told
+	}
+	_sortThreads = (threads < 1) ? 1 : threads;
+	_parallelSortThreshold = threshold;
+}
+
+//SetSortStatus()
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> void LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::SetSortStatus(SortOrder SortBy){
+	_SortStatus = SortBy;
+	_index.Clear();			//Rebuilt when it is next needed
 }
 
 //Reverse()
-template <typename TData> void LinkedList<TData>::Reverse(){
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> void LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::Reverse(){
 	ListNode<TData> *previous, *current, *next;
 	if (_firstNode == NULL){
 		return;
@@ -542,6 +896,7 @@ template <typename TData> void LinkedList<TData>::Reverse(){
 		return;
 	}
 	//cout << "Reversing" << endl;
+	_lastNode = _firstNode;
 	while (next != NULL){
 		current -> SetNext(previous);
 		previous = current;
@@ -550,6 +905,8 @@ template <typename TData> void LinkedList<TData>::Reverse(){
 	}
 	current -> SetNext(previous);
 	_firstNode = current;
+	_index.Clear();			//Rebuilt when it is next needed
+	_hashIndex.Reset();
 
 	Rewind();
 
@@ -566,149 +923,177 @@ template <typename TData> void LinkedList<TData>::Reverse(){
 	}
 }
 
-//DeleteNode
-
-template<typename TData> template <typename TSearch> int LinkedList<TData>::DeleteNode(TSearch data, int n){
-	int count = 0;
-	ListNode<TData> *previous, *current, *next;
-	previous = NULL;
-	current = _firstNode;
-	if (current == NULL){
-		return 0;
-	}
-	//Only one node
-	if (current -> Next() == NULL){
-		if (current -> Data() == data){			//Data matched, let's delete!
-			DestroyNode(current);
+//DeleteNodesBatch()
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> int LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::DeleteNodesBatch(const std::vector<int> &keys, const std::vector<int> &counts, std::vector<int> &deleted){
+	return DeleteNodesBatch(keys, counts, deleted, [](TData &data){ return (int) data; });
+}
 
-			_firstNode = NULL;
-			return 1;
-		}
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> void LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::DeleteNode(ListNode<TData> *Node, ListNode<TData> *previous){
+	if (previous == NULL && Node != _firstNode){
+		previous = _FindPrevious(Node);
 	}
-	next = current -> Next();
-
-	while ( (n > 0 || n == -1) && current != NULL){			//Need to check if the item delete counter
-		if (current -> Data() == data){
-			DestroyNode(current);
-			if (previous == NULL){
-				_firstNode = next;
-			}
-			else{
-				previous -> SetNext(next);
-			}
-			count++;
-			if (n != -1){			//-1 is to delete ALL items that match
-				n--;
-			}
-			if (next == NULL){
-				break;
-			}
-			current = next;
-			next = current -> Next();
-		}
-		else{
-			if (next == NULL){
-				break;
-			}
-			previous = current;
-			current = next;
-			next = current -> Next();
-		}
+	if (previous != NULL || Node == _firstNode){		//Otherwise, Node is not in the list
+		_Unlink(Node, previous);
 	}
+	DestroyNode(Node);
 	Rewind();
-	return count;
 }
 
-template <typename TData> void LinkedList<TData>::DeleteNode(ListNode<TData> *Node, ListNode<TData> *previous){
-	if (previous != NULL){
-		previous ->SetNext(Node -> Next());
+//Clear()
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> void LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::Clear(){
+	ListNode<TData> *current = _firstNode, *next;
+	while (current != NULL){
+		next = current -> Next();
+		DestroyNode(current);
+		current = next;
 	}
-	DestroyNode(Node);
+	_firstNode = _lastNode = NULL;
+	_length = 0;
+	_SortStatus = Unordered;
+	_index.Clear();
+	_hashIndex.Reset();
+	_aggregates.Reset();
 	Rewind();
 }
 
 
 //AppendNode()
-template <typename TData> void LinkedList<TData>::AppendNode(ListNode<TData> *Node, ListNode<TData> *NewNode){
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> void LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::AppendNode(ListNode<TData> *Node, ListNode<TData> *NewNode){
 	_SortStatus = Unordered;
+	_index.Clear();
+	if (Node == _lastNode && NewNode -> Next() == NULL){		//The usual case. Simply append NewNode
+		_LinkAfter(NewNode, Node);
+		return;
+	}
+	//Nodes after Node are cut off from the list, and all the nodes chained to NewNode are appended. Recount everything.
 	Node -> SetNext(NewNode);
+	_hashIndex.Reset();
+	_aggregates.Reset();
+	_Recount();
 }
-template <typename TData> ListNode<TData> *LinkedList<TData>::AppendNode(ListNode<TData> *Node, TData data){
-	_SortStatus = Unordered;
-	ListNode<TData> *NewNode = CreateNode(data);
-	Node -> SetNext(NewNode);
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> ListNode<TData> *LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::AppendNode(ListNode<TData> *Node, TData data){
+	ListNode<TData> *NewNode = CreateNode(std::move(data));
+	AppendNode(Node, NewNode);
 	return NewNode;
 
 }
-template <typename TData> ListNode<TData> *LinkedList<TData>::AppendNode(ListNode<TData> *Node){
-	_SortStatus = Unordered;
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> ListNode<TData> *LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::AppendNode(ListNode<TData> *Node){
 	ListNode<TData> *NewNode = CreateNode();
-	Node -> SetNext(NewNode);
+	AppendNode(Node, NewNode);
 	return NewNode;
 
 }			
 
 //InsertNodeAfter()
-template  <typename TData> void LinkedList<TData>::InsertNodeAfter(ListNode<TData> *RefNode, ListNode<TData> *NewNode){
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> void LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::InsertNodeAfter(ListNode<TData> *RefNode, ListNode<TData> *NewNode){
 	_SortStatus = Unordered;
-	NewNode -> SetNext(RefNode -> Next());
-	RefNode ->SetNext(NewNode);
+	_index.Clear();
+	_LinkAfter(NewNode, RefNode);
 }
-template <typename TData> ListNode<TData> *LinkedList<TData>::InsertNodeAfter(ListNode<TData> *RefNode, TData NewData){
-	_SortStatus = Unordered;
-	ListNode<TData> *NewNode = CreateNode(NewData);
-	NewNode -> SetNext(RefNode -> Next());
-	RefNode ->SetNext(NewNode);
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> ListNode<TData> *LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::InsertNodeAfter(ListNode<TData> *RefNode, TData NewData){
+	ListNode<TData> *NewNode = CreateNode(std::move(NewData));
+	InsertNodeAfter(RefNode, NewNode);
 	return NewNode;
 }
-template <typename TData> ListNode<TData> *LinkedList<TData>::InsertNodeAfter(ListNode<TData> *RefNode){
-	_SortStatus = Unordered;
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> template <typename... TArgs> ListNode<TData> *LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::EmplaceNodeAfter(ListNode<TData> *RefNode, TArgs&&... args){
+	ListNode<TData> *NewNode = EmplaceNode(std::forward<TArgs>(args)...);
+	InsertNodeAfter(RefNode, NewNode);
+	return NewNode;
+}
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> ListNode<TData> *LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::InsertNodeAfter(ListNode<TData> *RefNode){
 	ListNode<TData> *NewNode = CreateNode();
-	NewNode -> SetNext(RefNode -> Next());
-	RefNode ->SetNext(NewNode);
+	InsertNodeAfter(RefNode, NewNode);
 	return NewNode;
 }
 /*
-	Static Methods
+	Index Related
+*/
+//EnableIndex()
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> void LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::EnableIndex(bool enable){
+	_indexEnabled = enable;
+	if (!enable){
+		_index.Clear();
+	}
+}
+//_IndexReady()
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> bool LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::_IndexReady(){
+	if (!_indexEnabled || !_IntKeyed || _SortStatus == Unordered){
+		return false;
+	}
+	if (!_index.IsBuilt()){
+		_index.Build(_firstNode, _SortStatus == Ascending);
+	}
+	return true;
+}
+//SeekNumber()
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> ListNode<TData> *LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::SeekNumber(int number){
+	if (_IndexReady()){
+		return _index.Find(number);
+	}
+	ListNode<TData> *current = _firstNode;
+	while (current != NULL && (int) current -> Data() != number){
+		current = current -> Next();
+	}
+	return current;
+}
+//SeekPosition()
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> ListNode<TData> *LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::SeekPosition(int position){
+	if (position < 0 || position >= _length){
+		return NULL;
+	}
+	if (_IndexReady()){
+		return _index.Seek(position);
+	}
+	ListNode<TData> *current = _firstNode;
+	while (position-- > 0){
+		current = current -> Next();
+	}
+	return current;
+}
+
+/*
+	Node Factory Methods
 */
 //CreateNode()
-template <typename TData> ListNode<TData> *LinkedList<TData>::CreateNode(){
-	return new ListNode<TData>;
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> ListNode<TData> *LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::CreateNode(){
+	TInstrumentation::Allocated();
+	return new (_allocator.Allocate()) ListNode<TData>;
 }
-template <typename TData> ListNode<TData> *LinkedList<TData>::CreateNode(TData data){
-	ListNode<TData> *node = new ListNode<TData>;
-	node -> SetData(data);
-	return node;
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> ListNode<TData> *LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::CreateNode(TData data){
+	TInstrumentation::Allocated();
+	return new (_allocator.Allocate()) ListNode<TData>(std::move(data));
+}
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> template <typename... TArgs> ListNode<TData> *LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::EmplaceNode(TArgs&&... args){
+	TInstrumentation::Allocated();
+	return new (_allocator.Allocate()) ListNode<TData>(typename ListNode<TData>::InPlace(), std::forward<TArgs>(args)...);
 }
 
 //DestroyNode
-template <typename TData> void LinkedList<TData>::DestroyNode(ListNode<TData> *Node){
-	delete Node;
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> void LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::DestroyNode(ListNode<TData> *Node){
+	TInstrumentation::Freed();
+	Node -> ~ListNode<TData>();
+	_allocator.Deallocate(Node);
 }
 
 //DeleteNodesChained
-template <typename TData> void LinkedList<TData>::DeleteNodesChained(ListNode<TData> *Node, ListNode<TData> *previous){
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> void LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::DeleteNodesChained(ListNode<TData> *Node, ListNode<TData> *previous){
 	Rewind();
-	if (previous != NULL){
-		previous -> SetNext(NULL);
-	}
-	else if (Node == _firstNode){
-		_firstNode = NULL;
-	}
-	if (Node == NULL){
-		return;
+	if (previous == NULL && Node != _firstNode){
+		previous = _FindPrevious(Node);
 	}
-	else{
-		ListNode<TData> *next;
-		while (Node != NULL){
-			next = Node -> Next();
-			DestroyNode(Node);
-			Node = next;
+	bool found = (previous != NULL || Node == _firstNode);		//Otherwise, Node is not in the list
+	ListNode<TData> *next;
+	while (Node != NULL){
+		next = Node -> Next();
+		if (found){
+			_Unlink(Node, previous);
 		}
+		DestroyNode(Node);
+		Node = next;
 	}
 }
 
-template <typename TData> template <typename TSearch> bool LinkedList<TData>::DeleteNodesChained(TSearch data){
+template <typename TData, typename TAllocator, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation> template <typename TSearch> bool LinkedList<TData, TAllocator, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation>::DeleteNodesChained(TSearch data){
 	ListNode<TData> *current, *previous;
 	//Normally, in order not to disturb the internal pointer, I will search for the node manually in the method. But since
 	//the internal pointer is going to be rewinded anyway, might as well make use of existing methods.
@@ -721,4 +1106,520 @@ template <typename TData> template <typename TSearch> bool LinkedList<TData>::De
 	return false;
 }
 
+/*
+	UnrolledLinkedList is a linked list that stores up to N elements in each node, in a small fixed size array.
+	A traversal only follows a pointer once every N elements, so scanning the list is close to scanning an array.
+	A node is split in two when an element is inserted into it while it is full, and is merged into the node before it
+	when both fit into one node after a deletion. N must be at least 2.
+
+	UnrolledLinkedList has the same public methods as LinkedList that the program uses, so either can be used for the list.
+	The iteration methods return a pointer to an Item instead of a ListNode. Like ListNode, Item has the method Data().
+	Inserting or deleting elements moves elements around, so pointers to Items are only valid until the list is modified.
+*/
+template <typename TData=int, int N=16> class UnrolledLinkedList{
+	public:
+		//An element of the list
+		class Item{
+			TData _data;
+			public:
+				TData &Data(){ return _data; }		//Gets a reference to the data
+		};
+
+	private:
+		struct Node{
+			Item Items[N];		//Elements. Only the first Count elements are in use
+			int Count;
+			Node *Next;
+		};
+		//Used by Sort() to compare elements
+		struct _SortCompare{
+			SortOrder SortBy;
+			_SortCompare(SortOrder sortBy){ SortBy = sortBy; }
+			bool operator()(Item *a, Item *b) const {
+				return (SortBy == Ascending) ? ((int) a->Data() < (int) b->Data()) : ((int) a->Data() > (int) b->Data());
+			}
+		};
+
+		Node *_firstNode, *_lastNode;		//First and last node of the list
+		int _length;						//Number of elements in the list
+		Node *_current;						//Internal pointer. Node and index within the node of the current element
+		int _index;
+		Item *_previous;					//Previous element
+
+		Node *_NewNodeAfter(Node *previous);			//Creates an empty node after previous, or at the head if previous is NULL
+		void _RemoveNode(Node *previous, Node *node);	//Unlinks and deletes node. previous is the node before it, if any
+		Item *_InsertAt(Node *node, int index, TData &data);	//Moves data to index in node, splitting the node if it is full
+		void _Clear(Node *node);						//Deletes the chain of nodes starting at node
+		//Deletes the elements for which match(TData &) returns true, up to n of them (all of them if n is -1)
+		template <typename TMatch> int _DeleteMatching(TMatch match, int n);
+		//SearchForNode() and DeleteNode(), after the search is passed through SearchKey
+		template <typename TSearch> Item *_SearchForNode(TSearch search);
+		template <typename TSearch> int _DeleteNode(TSearch data, int n);
+
+		//Lists own their nodes, so they cannot be copied
+		UnrolledLinkedList(const UnrolledLinkedList &);
+		UnrolledLinkedList &operator=(const UnrolledLinkedList &);
+
+	public:
+		//Constructor
+		UnrolledLinkedList();
+		//Destructor
+		~UnrolledLinkedList();
+
+		/*
+			Retrieving Methods
+		*/
+		int Length(){ return _length; }		//Returns the number of elements
+		long long Sum();	//Sum of the int() values of the elements
+		int Min();			//Minimum of the int() values of the elements. 0 if the list is empty
+		int Max();			//Maximum of the int() values of the elements. 0 if the list is empty
+
+		/*
+			Iteration Methods. These behave like the ones in LinkedList
+		*/
+		void Rewind();
+		Item *Next();
+		Item *Previous();
+		Item *Current();
+		template <typename TSearch> Item *SearchForNode(TSearch search){ return _SearchForNode(SearchKey<TData>::Of(search)); }
+		bool IsLast();
+		bool IsFirst();
+
+		/*
+			Modifying Methods. These behave like the ones in LinkedList
+		*/
+		Item *InsertNewNode(TData data);			//Insert at the head of the list. Sets SortStatus to Unordered
+		Item *PushBack(TData data);					//Append at the end of the list. Sets SortStatus to Unordered
+		Item *InsertNewNodeOrdered(TData data);		//Insert in the order determined by SortStatus
+		//Construct the data from args. Elements live in arrays that are constructed with their node, so the data is
+		//constructed once and then moved into place.
+		template <typename... TArgs> Item *EmplaceNewNode(TArgs&&... args){ return InsertNewNode(TData(std::forward<TArgs>(args)...)); }
+		template <typename... TArgs> Item *EmplaceBack(TArgs&&... args){ return PushBack(TData(std::forward<TArgs>(args)...)); }
+		template <typename... TArgs> Item *EmplaceNewNodeOrdered(TArgs&&... args){
+			return InsertNewNodeOrdered(TData(std::forward<TArgs>(args)...));
+		}
+		//Insert the records in [first, last) as if InsertNewNodeOrdered() was called for each of them in turn. The records
+		//are copied, or moved with std::move_iterators, as in LinkedList. Nodes are skipped whole while looking for where
+		//to insert, so this is done one at a time.
+		template <typename TIterator> void InsertOrderedBatch(TIterator first, TIterator last){
+			for (; first != last; ++first){
+				InsertNewNodeOrdered(*first);
+			}
+		}
+		template <typename TSearch> int DeleteNode(TSearch data, int n = -1){ return _DeleteNode(SearchKey<TData>::Of(data), n); }
+		void Clear();		//Delete every element. The list is left empty and Unordered
+		//See LinkedList::DeleteNodesBatch(). The list is always walked once
+		template <typename TSearch, typename TKeyOf> int DeleteNodesBatch(const std::vector<TSearch> &keys, const std::vector<int> &counts, std::vector<int> &deleted, TKeyOf keyOf);
+		int DeleteNodesBatch(const std::vector<int> &keys, const std::vector<int> &counts, std::vector<int> &deleted){
+			return DeleteNodesBatch(keys, counts, deleted, [](TData &data){ return (int) data; });
+		}
+
+		/*
+			Sort Related
+		*/
+		void Reverse();
+		SortOrder GetSortStatus(){ return _SortStatus; }
+		//Declare that the list is already in SortBy order, without sorting it. The caller must make sure that it is.
+		//Used when a list that was saved in order is loaded back.
+		void SetSortStatus(SortOrder SortBy);
+		void Sort(SortOrder SortBy = Ascending);		//Stable sort. Implicitly calls Rewind(). Changes SortStatus
+
+	protected:
+		SortOrder _SortStatus;			//Stores the sort status of the list
+};
+
+/*
+	Constructor
+*/
+template <typename TData, int N> UnrolledLinkedList<TData, N>::UnrolledLinkedList(){
+	_firstNode = _lastNode = NULL;
+	_length = 0;
+	_SortStatus = Unordered;
+	Rewind();
+}
+
+/*
+	Destructor
+*/
+template <typename TData, int N> UnrolledLinkedList<TData, N>::~UnrolledLinkedList(){
+	_Clear(_firstNode);
+}
+
+/*
+	Helper Methods
+*/
+//_NewNodeAfter()
+template <typename TData, int N> typename UnrolledLinkedList<TData, N>::Node *UnrolledLinkedList<TData, N>::_NewNodeAfter(Node *previous){
+	Node *node = new Node;
+	node -> Count = 0;
+	if (previous == NULL){
+		node -> Next = _firstNode;
+		_firstNode = node;
+	}
+	else{
+		node -> Next = previous -> Next;
+		previous -> Next = node;
+	}
+	if (node -> Next == NULL){
+		_lastNode = node;
+	}
+	return node;
+}
+//_RemoveNode()
+template <typename TData, int N> void UnrolledLinkedList<TData, N>::_RemoveNode(Node *previous, Node *node){
+	if (previous == NULL){
+		_firstNode = node -> Next;
+	}
+	else{
+		previous -> Next = node -> Next;
+	}
+	if (node == _lastNode){
+		_lastNode = previous;
+	}
+	delete node;
+}
+//_InsertAt()
+template <typename TData, int N> typename UnrolledLinkedList<TData, N>::Item *UnrolledLinkedList<TData, N>::_InsertAt(Node *node, int index, TData &data){
+	if (node -> Count == N){		//Full. Move the upper half into a new node
+		Node *next = _NewNodeAfter(node);
+		int half = N / 2;
+		for (int i = half; i < N; i++){
+			next -> Items[i - half].Data() = std::move(node -> Items[i].Data());
+		}
+		next -> Count = N - half;
+		node -> Count = half;
+		if (index > half){
+			node = next;
+			index -= half;
+		}
+	}
+	for (int i = node -> Count; i > index; i--){
+		node -> Items[i].Data() = std::move(node -> Items[i - 1].Data());
+	}
+	node -> Items[index].Data() = std::move(data);
+	node -> Count++;
+	_length++;
+	return &node -> Items[index];
+}
+//_Clear()
+template <typename TData, int N> void UnrolledLinkedList<TData, N>::_Clear(Node *node){
+	Node *next;
+	while (node != NULL){
+		next = node -> Next;
+		delete node;
+		node = next;
+	}
+}
+
+/*
+	Retrieving Methods
+*/
+//Sum()
+template <typename TData, int N> long long UnrolledLinkedList<TData, N>::Sum(){
+	long long sum = 0;
+	for (Node *node = _firstNode; node != NULL; node = node -> Next){
+		for (int i = 0; i < node -> Count; i++){
+			sum += (int) node -> Items[i].Data();
+		}
+	}
+	return sum;
+}
+//Min()
+template <typename TData, int N> int UnrolledLinkedList<TData, N>::Min(){
+	if (_firstNode == NULL){
+		return 0;
+	}
+	int min = (int) _firstNode -> Items[0].Data();
+	for (Node *node = _firstNode; node != NULL; node = node -> Next){
+		for (int i = 0; i < node -> Count; i++){
+			if ((int) node -> Items[i].Data() < min){
+				min = (int) node -> Items[i].Data();
+			}
+		}
+	}
+	return min;
+}
+//Max()
+template <typename TData, int N> int UnrolledLinkedList<TData, N>::Max(){
+	if (_firstNode == NULL){
+		return 0;
+	}
+	int max = (int) _firstNode -> Items[0].Data();
+	for (Node *node = _firstNode; node != NULL; node = node -> Next){
+		for (int i = 0; i < node -> Count; i++){
+			if ((int) node -> Items[i].Data() > max){
+				max = (int) node -> Items[i].Data();
+			}
+		}
+	}
+	return max;
+}
+
+/*
+	Iteration Methods
+*/
+//Rewind()
+template <typename TData, int N> void UnrolledLinkedList<TData, N>::Rewind(){
+	_current = _firstNode;
+	_index = 0;
+	_previous = NULL;
+}
+//IsFirst()
+template <typename TData, int N> bool UnrolledLinkedList<TData, N>::IsFirst(){
+	return (_current == _firstNode && _index == 0);
+}
+//IsLast()
+template <typename TData, int N> bool UnrolledLinkedList<TData, N>::IsLast(){
+	if (_current == NULL){
+		return true;
+	}
+	return (_current -> Next == NULL && _index == _current -> Count - 1);
+}
+//Previous()
+template <typename TData, int N> typename UnrolledLinkedList<TData, N>::Item *UnrolledLinkedList<TData, N>::Previous(){
+	if (IsFirst()){
+		return NULL;
+	}
+	return _previous;
+}
+//Next()
+template <typename TData, int N> typename UnrolledLinkedList<TData, N>::Item *UnrolledLinkedList<TData, N>::Next(){
+	if (_current == NULL){
+		return NULL;
+	}
+	_previous = &_current -> Items[_index];
+	if (++_index == _current -> Count){
+		_current = _current -> Next;
+		_index = 0;
+	}
+	return Current();
+}
+//Current()
+template <typename TData, int N> typename UnrolledLinkedList<TData, N>::Item *UnrolledLinkedList<TData, N>::Current(){
+	if (_current == NULL){
+		return NULL;
+	}
+	return &_current -> Items[_index];
+}
+//SearchForNode()
+template <typename TData, int N> template <typename TSearch> typename UnrolledLinkedList<TData, N>::Item *UnrolledLinkedList<TData, N>::_SearchForNode(TSearch search){
+	while (Current() != NULL){
+		if (Current() -> Data() == search){
+			return Current();
+		}
+		Next();
+	}
+	return NULL;
+}
+
+/*
+	Modification Methods
+*/
+//InsertNewNode()
+template <typename TData, int N> typename UnrolledLinkedList<TData, N>::Item *UnrolledLinkedList<TData, N>::InsertNewNode(TData data){
+	_SortStatus = Unordered;
+	if (_firstNode == NULL){
+		_NewNodeAfter(NULL);
+	}
+	return _InsertAt(_firstNode, 0, data);
+}
+//PushBack()
+template <typename TData, int N> typename UnrolledLinkedList<TData, N>::Item *UnrolledLinkedList<TData, N>::PushBack(TData data){
+	_SortStatus = Unordered;
+	if (_lastNode == NULL || _lastNode -> Count == N){		//Start a new node rather than split, so that loaded nodes are full
+		_NewNodeAfter(_lastNode);
+	}
+	return _InsertAt(_lastNode, _lastNode -> Count, data);
+}
+//InsertNewNodeOrdered()
+//Insert before the first element that satisfies the SortStatus. Whole nodes are skipped by looking at their last element.
+template <typename TData, int N> typename UnrolledLinkedList<TData, N>::Item *UnrolledLinkedList<TData, N>::InsertNewNodeOrdered(TData data){
+	if (_SortStatus == Unordered){
+		return InsertNewNode(std::move(data));			//Unordered? Just add the node to the head of the list!
+	}
+	int key = (int) data;
+	bool ascending = (_SortStatus == Ascending);
+	Node *node = _firstNode;
+	while (node != NULL){
+		int last = (int) node -> Items[node -> Count - 1].Data();
+		if (ascending ? (last >= key) : (last <= key)){
+			break;
+		}
+		node = node -> Next;
+	}
+	if (node == NULL){		//Largest (ASC) or smallest (DSC). Append it to the back
+		if (_lastNode == NULL){
+			_NewNodeAfter(NULL);
+		}
+		return _InsertAt(_lastNode, _lastNode -> Count, data);
+	}
+	int index = 0;
+	while (ascending ? ((int) node -> Items[index].Data() < key) : ((int) node -> Items[index].Data() > key)){
+		index++;
+	}
+	return _InsertAt(node, index, data);
+}
+//DeleteNode()
+//Deletes the first n elements matching data (all of them if n is -1). Each node is compacted in place, then merged into
+//the node before it if they fit into one node. Returns the number of elements deleted. Causes Rewind() to be called.
+template <typename TData, int N> template <typename TSearch> int UnrolledLinkedList<TData, N>::_DeleteNode(TSearch data, int n){
+	return _DeleteMatching([&data](TData &item){ return (item == data); }, n);
+}
+//Clear()
+template <typename TData, int N> void UnrolledLinkedList<TData, N>::Clear(){
+	_Clear(_firstNode);
+	_firstNode = _lastNode = NULL;
+	_length = 0;
+	_SortStatus = Unordered;
+	Rewind();
+}
+//DeleteNodesBatch()
+template <typename TData, int N> template <typename TSearch, typename TKeyOf> int UnrolledLinkedList<TData, N>::DeleteNodesBatch(const std::vector<TSearch> &keys, const std::vector<int> &counts, std::vector<int> &deleted, TKeyOf keyOf){
+	deleted.assign(keys.size(), 0);
+	//The requests still to be satisfied for each key, in the order they were given. See LinkedList::DeleteNodesBatch()
+	std::unordered_map<TSearch, std::deque<size_t> > wanted;
+	int limit = 0;			//Total number of elements to delete, so that the walk can stop early. -1 if there is no limit
+	for (size_t i = 0; i < keys.size(); i++){
+		if (counts[i] != 0){
+			wanted[keys[i]].push_back(i);
+		}
+		limit = (limit == -1 || counts[i] == -1) ? -1 : limit + counts[i];
+	}
+	if (limit == 0){
+		return 0;
+	}
+	return _DeleteMatching([&](TData &item){
+		typename std::unordered_map<TSearch, std::deque<size_t> >::iterator found = wanted.find(keyOf(item));
+		if (found == wanted.end()){
+			return false;
+		}
+		size_t request = found -> second.front();
+		if (++deleted[request] == counts[request]){
+			found -> second.pop_front();
+			if (found -> second.empty()){
+				wanted.erase(found);
+			}
+		}
+		return true;
+	}, limit);
+}
+//_DeleteMatching()
+template <typename TData, int N> template <typename TMatch> int UnrolledLinkedList<TData, N>::_DeleteMatching(TMatch match, int n){
+	int count = 0;
+	Node *previous = NULL, *node = _firstNode, *next;
+	while (node != NULL && (n > 0 || n == -1)){
+		next = node -> Next;
+		int write = 0;
+		for (int read = 0; read < node -> Count; read++){
+			if ((n > 0 || n == -1) && match(node -> Items[read].Data())){
+				count++;
+				if (n != -1){			//-1 is to delete ALL items that match
+					n--;
+				}
+			}
+			else{
+				if (write != read){
+					node -> Items[write].Data() = std::move(node -> Items[read].Data());
+				}
+				write++;
+			}
+		}
+		if (write != node -> Count){
+			for (int i = write; i < node -> Count; i++){
+				node -> Items[i].Data() = TData();		//Release whatever the deleted elements hold
+			}
+			_length -= node -> Count - write;
+			node -> Count = write;
+			if (write == 0){
+				_RemoveNode(previous, node);
+				node = previous;
+			}
+			else if (previous != NULL && previous -> Count + node -> Count <= N){		//Merge into the previous node
+				for (int i = 0; i < node -> Count; i++){
+					previous -> Items[previous -> Count + i].Data() = std::move(node -> Items[i].Data());
+				}
+				previous -> Count += node -> Count;
+				_RemoveNode(previous, node);
+				node = previous;
+			}
+		}
+		previous = node;
+		node = next;
+	}
+	Rewind();
+	return count;
+}
+
+/*
+	Sort Related
+*/
+//Reverse()
+//Reverses the chain of nodes, and the elements within each node
+template <typename TData, int N> void UnrolledLinkedList<TData, N>::Reverse(){
+	if (_length < 2){
+		return;
+	}
+	Node *previous = NULL, *node = _firstNode, *next;
+	_lastNode = _firstNode;
+	while (node != NULL){
+		next = node -> Next;
+		node -> Next = previous;
+		for (int i = 0, j = node -> Count - 1; i < j; i++, j--){
+			std::swap(node -> Items[i].Data(), node -> Items[j].Data());
+		}
+		previous = node;
+		node = next;
+	}
+	_firstNode = previous;
+
+	Rewind();
+
+	switch (_SortStatus){
+		case Ascending:
+			_SortStatus = Descending;
+			break;
+		case Descending:
+			_SortStatus = Ascending;
+			break;
+		default:
+			_SortStatus = Unordered;
+			break;
+	}
+}
+//SetSortStatus()
+template <typename TData, int N> void UnrolledLinkedList<TData, N>::SetSortStatus(SortOrder SortBy){
+	_SortStatus = SortBy;
+}
+//Sort()
+//The elements are sorted through an array of pointers with a stable sort, then copied into a new, fully packed chain of nodes.
+template <typename TData, int N> void UnrolledLinkedList<TData, N>::Sort(SortOrder SortBy){
+	if (SortBy == Unordered){
+		return;
+	}
+	if (_length < 2){		//Zero or 1 Item?
+		return;
+	}
+	std::vector<Item *> items;
+	items.reserve(_length);
+	for (Node *node = _firstNode; node != NULL; node = node -> Next){
+		for (int i = 0; i < node -> Count; i++){
+			items.push_back(&node -> Items[i]);
+		}
+	}
+	std::stable_sort(items.begin(), items.end(), _SortCompare(SortBy));
+
+	Node *oldNodes = _firstNode;
+	_firstNode = _lastNode = NULL;
+	for (size_t i = 0; i < items.size(); i++){
+		if (_lastNode == NULL || _lastNode -> Count == N){
+			_NewNodeAfter(_lastNode);
+		}
+		_lastNode -> Items[_lastNode -> Count++].Data() = std::move(items[i] -> Data());		//The old nodes are thrown away
+	}
+	_Clear(oldNodes);
+
+	_SortStatus = SortBy;
+	Rewind();
+}
+
 #endif /* List_H */
\ No newline at end of file
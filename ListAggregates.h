@@ -0,0 +1,158 @@
+/*
+	Yong Wen Chua
+	http://bit.ly/yongwen
+	Released under the LGPL license
+*/
+/*
+	Aggregate policies for LinkedList.
+
+	An aggregate policy answers the sum, minimum and maximum of the int() values of the nodes in a list.
+	A policy has to implement the following. LinkedList calls the first three as it modifies the list.
+		- void Added(ListNode<TData> *Node)		Node has been linked into the list
+		- void Removed(ListNode<TData> *Node)	Node is being unlinked from the list. Its data is still intact
+		- void Reset()							The nodes of the list have been replaced as a whole
+		- long long Sum(ListNode<TData> *First)
+		- int Min(ListNode<TData> *First)		Returns 0 if the list is empty
+		- int Max(ListNode<TData> *First)		Returns 0 if the list is empty
+			First is the first node of the list, for policies that need to walk it.
+
+	NoAggregates keeps nothing and walks the list for every query.
+	ListAggregates keeps a running sum, minimum and maximum, so that queries take constant time. It also counts how many nodes
+	hold the minimum and the maximum. Only when the last of them is removed does it need to walk the list again, which
+	it does when it is next queried.
+*/
+//These Macros ensure that the file is only #included once.
+#pragma once
+#ifndef ListAggregates_H
+#define ListAggregates_H
+
+#include <cstddef>
+#include "ListNode.h"
+
+template <typename TData> class NoAggregates{
+	public:
+		void Added(ListNode<TData> *){}
+		void Removed(ListNode<TData> *){}
+		void Reset(){}
+
+		long long Sum(ListNode<TData> *First){
+			long long sum = 0;
+			for (ListNode<TData> *node = First; node != NULL; node = node -> Next()){
+				sum += (int) node -> Data();
+			}
+			return sum;
+		}
+		int Min(ListNode<TData> *First){
+			if (First == NULL){
+				return 0;
+			}
+			int min = (int) First -> Data();
+			for (ListNode<TData> *node = First -> Next(); node != NULL; node = node -> Next()){
+				if ((int) node -> Data() < min){
+					min = (int) node -> Data();
+				}
+			}
+			return min;
+		}
+		int Max(ListNode<TData> *First){
+			if (First == NULL){
+				return 0;
+			}
+			int max = (int) First -> Data();
+			for (ListNode<TData> *node = First -> Next(); node != NULL; node = node -> Next()){
+				if ((int) node -> Data() > max){
+					max = (int) node -> Data();
+				}
+			}
+			return max;
+		}
+};
+
+template <typename TData> class ListAggregates{
+	long long _sum;
+	int _count;					//Number of nodes
+	int _min, _max;
+	int _minCount, _maxCount;	//Number of nodes holding the minimum and the maximum
+	bool _stale;				//Set when the list has to be walked to find the aggregates again
+
+	void _Recompute(ListNode<TData> *First){
+		_sum = 0;
+		_count = 0;
+		_stale = false;
+		for (ListNode<TData> *node = First; node != NULL; node = node -> Next()){
+			Added(node);
+		}
+	}
+
+	public:
+		ListAggregates(){
+			_sum = 0;
+			_count = 0;
+			_min = _max = 0;
+			_minCount = _maxCount = 0;
+			_stale = false;
+		}
+
+		void Added(ListNode<TData> *Node){
+			if (_stale){
+				return;
+			}
+			int key = (int) Node -> Data();
+			_sum += key;
+			if (_count == 0 || key > _max){
+				_max = key;
+				_maxCount = 1;
+			}
+			else if (key == _max){
+				_maxCount++;
+			}
+			if (_count == 0 || key < _min){
+				_min = key;
+				_minCount = 1;
+			}
+			else if (key == _min){
+				_minCount++;
+			}
+			_count++;
+		}
+		void Removed(ListNode<TData> *Node){
+			if (_stale){
+				return;
+			}
+			int key = (int) Node -> Data();
+			_sum -= key;
+			_count--;
+			if (_count == 0){
+				_min = _max = 0;
+				_minCount = _maxCount = 0;
+				return;
+			}
+			if ((key == _max && --_maxCount == 0) || (key == _min && --_minCount == 0)){		//The last minimum or maximum is gone
+				_stale = true;
+			}
+		}
+		void Reset(){
+			_stale = true;
+		}
+
+		long long Sum(ListNode<TData> *First){
+			if (_stale){
+				_Recompute(First);
+			}
+			return _sum;
+		}
+		int Min(ListNode<TData> *First){
+			if (_stale){
+				_Recompute(First);
+			}
+			return (_count == 0) ? 0 : _min;
+		}
+		int Max(ListNode<TData> *First){
+			if (_stale){
+				_Recompute(First);
+			}
+			return (_count == 0) ? 0 : _max;
+		}
+};
+
+#endif /* ListAggregates_H */
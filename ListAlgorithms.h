@@ -0,0 +1,163 @@
+/*
+	Yong Wen Chua
+	http://bit.ly/yongwen
+	Released under the LGPL license
+*/
+/*
+	ListAlgorithms holds the batch inserts and the deletes that LinkedList and DoublyLinkedList share. They only differ in
+	the type of their nodes, which the methods below are templated on, along with the list.
+
+	A list that uses them makes ListAlgorithms a friend, and has the following private members:
+		- _firstNode								The first node of the list
+		- _SortStatus								The order of the list
+		- _hashIndex								The hash index policy of the list (see HashIndex.h)
+		- _Instrumentation							The instrumentation policy of the list (see Instrumentation.h)
+		- void _LinkAfter(TNode *Node, TNode *previous)		Links Node after previous, or at the head if previous is NULL
+		- void _Unlink(TNode *Node, TNode *previous)		Unlinks Node, which comes after previous. Node is not destroyed
+		- template <SortOrder Order> bool _SortHelper(TNode *a, TNode *b)	True if a has to be placed after b in Order order
+	and the public methods DestroyNode(TNode *), DeleteNode(TSearch, int) and Rewind().
+*/
+//These Macros ensure that the file is only #included once.
+#pragma once
+#ifndef ListAlgorithms_H
+#define ListAlgorithms_H
+
+#include <vector>
+#include <deque>
+#include <algorithm>
+#include <utility>
+#include <type_traits>
+#include <unordered_map>
+#include "ListNode.h"
+#include "SortPolicies.h"
+
+struct ListAlgorithms{
+	//Inserts batch, a vector of new nodes, into the ordered list as if InsertNewNodeOrdered() was called for each of them in
+	//turn. Inserting one node at a time puts each node before the nodes with the same key inserted before it, and before the
+	//nodes with the same key already in the list. So the batch is reversed, then sorted stably, and each node of the batch
+	//goes before the first node of the list it has to be inserted before. The list is walked once.
+	template <typename TList, typename TNode> static void InsertOrderedBatch(TList &list, std::vector<TNode *> &batch){
+		std::reverse(batch.begin(), batch.end());
+		if (list._SortStatus == Ascending){
+			_MergeBatch<Ascending>(list, batch);
+		}
+		else{
+			_MergeBatch<Descending>(list, batch);
+		}
+	}
+
+	//Deletes the first n nodes whose data == data (all of them if n is -1). Returns the number deleted. Calls Rewind()
+	template <typename TList, typename TSearch> static int DeleteNode(TList &list, TSearch data, int n){
+		typedef typename std::remove_pointer<decltype(list._firstNode)>::type TNode;
+		int count = 0;
+		ListNode<DataOf<TList> > *found, *before;
+		TNode *previous, *current, *next;
+		if (list._hashIndex.Find(data, list._firstNode, found, before)){		//The hash index can find the matching nodes
+			while ((n > 0 || n == -1) && found != NULL){
+				current = static_cast<TNode *>(found);
+				list._Unlink(current, static_cast<TNode *>(before));
+				list.DestroyNode(current);
+				count++;
+				if (n != -1){			//-1 is to delete ALL items that match
+					n--;
+				}
+				list._hashIndex.Find(data, list._firstNode, found, before);
+			}
+			list.Rewind();
+			return count;
+		}
+		previous = NULL;
+		current = list._firstNode;
+		while ((n > 0 || n == -1) && current != NULL){
+			TList::_Instrumentation::Stepped();
+			next = current -> Next();
+			if (current -> Data() == data){
+				list._Unlink(current, previous);
+				list.DestroyNode(current);
+				count++;
+				if (n != -1){			//-1 is to delete ALL items that match
+					n--;
+				}
+			}
+			else{
+				previous = current;
+			}
+			current = next;
+		}
+		list.Rewind();
+		return count;
+	}
+
+	//For each i, deletes the first counts[i] nodes matching keys[i] (all of them if counts[i] is -1), as if DeleteNode() was
+	//called for each key in turn. See LinkedList::DeleteNodesBatch()
+	template <typename TList, typename TSearch, typename TSearchOf> static int DeleteNodesBatch(TList &list, const std::vector<TSearch> &keys, const std::vector<int> &counts, std::vector<int> &deleted, TSearchOf keyOf){
+		typedef typename std::remove_pointer<decltype(list._firstNode)>::type TNode;
+		int total = 0;
+		deleted.assign(keys.size(), 0);
+		ListNode<DataOf<TList> > *found, *before;
+		if (keys.empty()){
+			return 0;
+		}
+		if (list._hashIndex.Find(keys[0], list._firstNode, found, before)){		//The hash index can find the matching nodes
+			for (size_t i = 0; i < keys.size(); i++){
+				deleted[i] = list.DeleteNode(keys[i], counts[i]);
+				total += deleted[i];
+			}
+			return total;
+		}
+		//The requests still to be satisfied for each key, in the order they were given
+		std::unordered_map<TSearch, std::deque<size_t> > wanted;
+		for (size_t i = 0; i < keys.size(); i++){
+			if (counts[i] != 0){
+				wanted[keys[i]].push_back(i);
+			}
+		}
+		TNode *previous = NULL, *current = list._firstNode, *next;
+		while (current != NULL && !wanted.empty()){
+			TList::_Instrumentation::Stepped();
+			next = current -> Next();
+			typename std::unordered_map<TSearch, std::deque<size_t> >::iterator match = wanted.find(keyOf(current -> Data()));
+			if (match != wanted.end()){
+				size_t request = match -> second.front();
+				if (++deleted[request] == counts[request]){		//Satisfied. A count of -1 never is
+					match -> second.pop_front();
+					if (match -> second.empty()){
+						wanted.erase(match);
+					}
+				}
+				list._Unlink(current, previous);
+				list.DestroyNode(current);
+				total++;
+			}
+			else{
+				previous = current;
+			}
+			current = next;
+		}
+		list.Rewind();
+		return total;
+	}
+
+	private:
+		//The type of the data of the nodes of TList
+		template <typename TList> using DataOf = typename std::decay<decltype(std::declval<TList &>()._firstNode -> Data())>::type;
+
+		//Sorts the batch stably and merges it into the list in one walk
+		template <SortOrder Order, typename TList, typename TNode> static void _MergeBatch(TList &list, std::vector<TNode *> &batch){
+			std::stable_sort(batch.begin(), batch.end(), [&list](TNode *a, TNode *b){
+				return list.template _SortHelper<Order>(b, a);
+			});
+			TNode *current = list._firstNode, *previous = NULL;
+			for (size_t i = 0; i < batch.size(); i++){
+				while (current != NULL && list.template _SortHelper<Order>(batch[i], current)){
+					TList::_Instrumentation::Stepped();
+					previous = current;
+					current = current -> Next();
+				}
+				list._LinkAfter(batch[i], previous);
+				previous = batch[i];
+			}
+		}
+};
+
+#endif /* ListAlgorithms_H */
@@ -7,6 +7,7 @@
 	Each node contains two elements
 		-> A pointer to the next node
 		-> An object of type TData
+	A DoublyListNode also contains a pointer to the previous node.
 
 	A new node SHOULD not be created manually but via the LinkedList class.
 	Because templates are used, we cannot separate the declaration from the definition into different files.
@@ -16,6 +17,16 @@
 #ifndef ListNode_H
 #define ListNode_H
 
+#include <cstddef>
+#include <utility>
+
+//Turns what a list is searched with into what the data of its nodes is compared with. By default, the search itself.
+//The lists pass every search through it once, so a data type can specialise it to prepare a search once instead of
+//on every comparison (see ListNodeData.h).
+template <typename TData> struct SearchKey{
+	template <typename TSearch> static const TSearch &Of(const TSearch &search){ return search; }
+};
+
 template <typename TData=int> class ListNode{
 	TData _data;
 	ListNode<TData> *_nextNode;
@@ -26,10 +37,14 @@ template <typename TData=int> class ListNode{
 			_nextNode = NULL;
 		}
 
-		ListNode(TData data, ListNode<TData> *next = NULL){		//Construct the node with information
-			SetData(data);
+		ListNode(TData data, ListNode<TData> *next = NULL) : _data(std::move(data)){		//Construct the node with information
 			SetNext(next);
 		}
+		//Construct the data of the node in place, from the arguments that follow InPlace. No TData is copied or moved.
+		struct InPlace{};
+		template <typename... TArgs> ListNode(InPlace, TArgs&&... args) : _data(std::forward<TArgs>(args)...){
+			_nextNode = NULL;
+		}
 		~ListNode(){
 			//cout << "Destroying Node " << int(_data) << endl;
 		}
@@ -49,9 +64,39 @@ template <typename TData=int> class ListNode{
 		}
 
 		//Set data to data.	
-		//Note: A copy of data will be made! Make sure to overload the copy mechanism in TData if necessary!
+		//Note: data is taken by value and moved into the node. Pass an rvalue (e.g. std::move()) to avoid making a copy.
 		void SetData(TData data){
-			_data = data;
+			_data = std::move(data);
+		}
+};
+
+//A node of DoublyLinkedList. It also links to the node before it.
+//All nodes of a DoublyLinkedList are DoublyListNodes, so Next() returns one.
+template <typename TData=int> class DoublyListNode : public ListNode<TData>{
+	DoublyListNode<TData> *_previousNode;
+
+	public:
+		DoublyListNode() : ListNode<TData>(){
+			_previousNode = NULL;
+		}
+		DoublyListNode(TData data) : ListNode<TData>(std::move(data)){
+			_previousNode = NULL;
+		}
+		template <typename... TArgs> DoublyListNode(typename ListNode<TData>::InPlace, TArgs&&... args) : ListNode<TData>(typename ListNode<TData>::InPlace(), std::forward<TArgs>(args)...){
+			_previousNode = NULL;
+		}
+
+		//Get a pointer to next node
+		DoublyListNode<TData> *Next(){
+			return static_cast<DoublyListNode<TData> *>(ListNode<TData>::Next());
+		}
+		//Get a pointer to previous node
+		DoublyListNode<TData> *Previous(){
+			return _previousNode;
+		}
+		//Set Pointer to previous node
+		void SetPrevious(DoublyListNode<TData> *previous){
+			_previousNode = previous;
 		}
 };
 #endif /* ListNode_H */
\ No newline at end of file
@@ -11,15 +11,31 @@
 using namespace std;
 
 //Friend Functions
-bool operator==(ListNodeData &op1, string op2){
+bool operator==(const ListNodeData &op1, const string &op2){
 	return (op1.Text() == op2);
 }
-bool operator==(string op1, ListNodeData &op2){
+bool operator==(const string &op1, const ListNodeData &op2){
 	return (op2.Text() == op1);
 }
-bool operator==(ListNodeData &op1, int op2){
+bool operator==(const ListNodeData &op1, const char *op2){
+	return (op1.Text().compare(op2) == 0);
+}
+bool operator==(const char *op1, const ListNodeData &op2){
+	return (op2.Text().compare(op1) == 0);
+}
+bool operator==(const ListNodeData &op1, ListNodeDataKey op2){
+#ifdef USE_STRING_POOL
+	return (op1._text == op2.Text);		//Interned texts are equal only if they are the same string
+#else
+	return (op1._text == *op2.Text);
+#endif
+}
+bool operator==(ListNodeDataKey op1, const ListNodeData &op2){
+	return (op2 == op1);
+}
+bool operator==(const ListNodeData &op1, int op2){
 	return ( int(op1) == op2);
 }
-bool operator==(int op1, ListNodeData &op2){
+bool operator==(int op1, const ListNodeData &op2){
 	return (op1 == int(op2));
 }
\ No newline at end of file
@@ -5,6 +5,11 @@
 */
 /*
 	Custom Data Type to meet requirements in the Assignment.
+
+	Define USE_STRING_POOL at compile time to keep the texts in StringPool::Shared() instead of in each object.
+	Each object then holds only a pointer to its text, and texts are compared by comparing pointers. Comparing data with a
+	string or C-string still compares characters, but the lists look a text they are searched for up once (see SearchKey below),
+	so that their searches only compare pointers.
 */
 //These Macros ensure that the file is only #included once.
 #pragma once
@@ -12,51 +17,174 @@
 #define ListNodeData_H
 
 #include <string>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <functional>
+#include "StringPool.h"
+#include "ListNode.h"
 using namespace std;
 
+//A text to search ListNodeData for, made by ListNodeData::Key(). With USE_STRING_POOL, comparing it with data only
+//compares pointers, so make the key once and reuse it for every comparison.
+//Keys can also be compared and hashed with each other, e.g. to key a hash table on them. See ListNodeDataTextKey
+struct ListNodeDataKey{
+	const string *Text;		//The pooled text, or NULL if no data can have it. Without USE_STRING_POOL, the text searched for,
+							//which has to outlive the key
+
+	#ifdef USE_STRING_POOL
+		bool operator==(const ListNodeDataKey &op) const { return (Text == op.Text); }
+	#else
+		bool operator==(const ListNodeDataKey &op) const { return (*Text == *op.Text); }
+	#endif
+	bool operator!=(const ListNodeDataKey &op) const { return !(*this == op); }
+};
+
+namespace std{
+	template <> struct hash<ListNodeDataKey>{
+		#ifdef USE_STRING_POOL
+			//The pooled strings sit at regular intervals in memory, so the bits of the pointer are mixed (MurmurHash3's finaliser)
+			size_t operator()(const ListNodeDataKey &key) const {
+				uint64_t bits = (uint64_t) (uintptr_t) key.Text;
+				bits ^= bits >> 33;
+				bits *= 0xff51afd7ed558ccdULL;
+				bits ^= bits >> 33;
+				bits *= 0xc4ceb9fe1a85ec53ULL;
+				bits ^= bits >> 33;
+				return (size_t) bits;
+			}
+		#else
+			size_t operator()(const ListNodeDataKey &key) const { return hash<string>()(*key.Text); }
+		#endif
+	};
+}
+
 class ListNodeData{
 	private:				//Private Members
 		int _number;			
-		string _text;
+		#ifdef USE_STRING_POOL
+			const string *_text;		//Interned in StringPool::Shared()
+			static const string *_Pooled(const string &text){ return StringPool::Shared().Intern(text); }
+		#else
+			string _text;
+		#endif
+		//Compares the pointers when the texts are pooled, and the texts otherwise
+		bool _SameText(const ListNodeData &op) const { return (_text == op._text); }
 
 	public:
 		//Constructors
-		ListNodeData(){}							//Default Uninitialised Constructor
-		ListNodeData(int number, string text){		//Constructor
-			SetNumber(number);
-			SetText(text);
-		}
-		ListNodeData(int number, char *text){		//C-string variant
-			SetNumber(number);
-			SetText(text);
-		}
+		#ifdef USE_STRING_POOL
+			ListNodeData(){ SetNumber(0); _text = _Pooled(string()); }			//Default Constructor. Empty text, number 0
+			ListNodeData(int number, const string &text){		//Constructor
+				SetNumber(number);
+				_text = _Pooled(text);
+			}
+			ListNodeData(int number, const char *text, size_t length){		//Text that is not terminated
+				SetNumber(number);
+				_text = StringPool::Shared().Intern(text, length);
+			}
+			ListNodeData(int number, const char *text){		//C-string variant
+				SetNumber(number);
+				SetText(text);
+			}
+		#else
+			ListNodeData(){ SetNumber(0); }			//Default Constructor. Empty text, number 0
+			ListNodeData(int number, string text) : _text(std::move(text)){		//Constructor. Pass text as an rvalue to avoid a copy
+				SetNumber(number);
+			}
+			ListNodeData(int number, const char *text, size_t length) : _text(text, length){		//Text that is not terminated
+				SetNumber(number);
+			}
+			ListNodeData(int number, const char *text){		//C-string variant
+				SetNumber(number);
+				SetText(text);
+			}
+		#endif
 		//Various Methods to set data
 		void SetNumber(int number){ _number = number; }		//Set the number
-		void SetText(string text){ _text = text; }		//Set the text
-		void SetText(char *text) { _text = text; };		//C-String variant
+		#ifdef USE_STRING_POOL
+			void SetText(const string &text){ _text = _Pooled(text); }		//Set the text
+			void SetText(const char *text) { _text = _Pooled(text); };		//C-String variant
+		#else
+			void SetText(const string &text){ _text = text; }		//Set the text
+			void SetText(string &&text){ _text = std::move(text); }		//Set the text, taking over its characters
+			void SetText(const char *text) { _text = text; };		//C-String variant
+		#endif
 		
-		//Methods to retrieve data
-		int Number(){ return _number; }			//Retrieve Number
-		string Text() { return _text; }			//Retrieve Text
+		//Methods to retrieve data. Text() returns a reference to the text held, so that reading it makes no copy.
+		int Number() const { return _number; }			//Retrieve Number
+		#ifdef USE_STRING_POOL
+			const string &Text() const { return *_text; }		//Retrieve Text
+		#else
+			const string &Text() const { return _text; }		//Retrieve Text
+		#endif
+
+		//The key of the text held. Unlike Key(), it does not look the text up
+		ListNodeDataKey TextKey() const {
+			ListNodeDataKey key;
+			#ifdef USE_STRING_POOL
+				key.Text = _text;
+			#else
+				key.Text = &_text;
+			#endif
+			return key;
+		}
+		//Makes a key to search for text with. See ListNodeDataKey
+		static ListNodeDataKey Key(const string &text){
+			ListNodeDataKey key;
+			#ifdef USE_STRING_POOL
+				key.Text = StringPool::Shared().Find(text);		//A text that was never interned cannot match anything
+			#else
+				key.Text = &text;
+			#endif
+			return key;
+		}
+		#ifndef USE_STRING_POOL
+			//The key points to the text, so it cannot be made from a temporary, e.g. Key(string(...)) or Key("John")
+			static ListNodeDataKey Key(string &&text) = delete;
+		#endif
 		
-		//Overloaded Operators
-		operator int(){ return _number; }									//Overloaded int type cast operator
-		bool operator<(ListNodeData &op){ return (int(*this) < int(op)); }	//Overloaded < comparison operator with integers
-		bool operator>(ListNodeData &op){ return (int(*this) > int(op)); }	//Overloaded > comparison operator with integers
-		bool operator<=(ListNodeData &op){ return (int(*this) <= int(op)); }	//Overloaded <= comparison operator with integers
-		bool operator>=(ListNodeData &op){ return (int(*this) >= int(op)); }	//Overloaded >= comparison operator with integers
-		bool operator==(ListNodeData &op){										//Overloaded == comparison with other data
-			return (this->Number() == op.Number() && this->Text() == op.Text());	
+		//Overloaded Operators. None of these copy the text.
+		operator int() const { return _number; }									//Overloaded int type cast operator
+		bool operator<(const ListNodeData &op) const { return (int(*this) < int(op)); }	//Overloaded < comparison operator with integers
+		bool operator>(const ListNodeData &op) const { return (int(*this) > int(op)); }	//Overloaded > comparison operator with integers
+		bool operator<=(const ListNodeData &op) const { return (int(*this) <= int(op)); }	//Overloaded <= comparison operator with integers
+		bool operator>=(const ListNodeData &op) const { return (int(*this) >= int(op)); }	//Overloaded >= comparison operator with integers
+		bool operator==(const ListNodeData &op) const {										//Overloaded == comparison with other data
+			return (this->Number() == op.Number() && _SameText(op));	
 		}
 		
 		//Friend functions are used so that comparison with integers/strings can be done in any order
-		friend bool operator==(ListNodeData &op1, string op2);			//Overloaded Operator for comparison with strings
-		friend bool operator==(string op1, ListNodeData &op2);			//Overloaded Operator for comparison with strings
-		friend bool operator==(ListNodeData &op1, int op2);				//Overloaded Operator for comparison with int
-		friend bool operator==(int op1, ListNodeData &op2);				//Overloaded Operator for comparison with int
+		friend bool operator==(const ListNodeData &op1, const string &op2);			//Overloaded Operator for comparison with strings
+		friend bool operator==(const string &op1, const ListNodeData &op2);			//Overloaded Operator for comparison with strings
+		friend bool operator==(const ListNodeData &op1, const char *op2);			//Comparison with C-strings, without making a string
+		friend bool operator==(const char *op1, const ListNodeData &op2);			//Comparison with C-strings, without making a string
+		friend bool operator==(const ListNodeData &op1, ListNodeDataKey op2);		//Comparison with a key made by Key()
+		friend bool operator==(ListNodeDataKey op1, const ListNodeData &op2);		//Comparison with a key made by Key()
+		friend bool operator==(const ListNodeData &op1, int op2);				//Overloaded Operator for comparison with int
+		friend bool operator==(int op1, const ListNodeData &op2);				//Overloaded Operator for comparison with int
 		
-		bool operator!=(ListNodeData &op){								//Overloaded != comparison operator.
-			return (this->Number() != op.Number() || this->Text() != op.Text());	
+		bool operator!=(const ListNodeData &op) const {								//Overloaded != comparison operator.
+			return (this->Number() != op.Number() || !_SameText(op));	
 		}
 };
-#endif /* ListNodeData_H */
\ No newline at end of file
+
+#ifdef USE_STRING_POOL
+//Lists searched for a text look it up in the pool once, and then only compare pointers. See SearchKey in ListNode.h
+template <> struct SearchKey<ListNodeData>{
+	template <typename TSearch> static const TSearch &Of(const TSearch &search){ return search; }
+	static ListNodeDataKey Of(const string &text){ return ListNodeData::Key(text); }
+	static ListNodeDataKey Of(const char *text){ return ListNodeData::Key(text); }
+};
+#endif
+
+//Key extractor for HashIndex. Indexes ListNodeData on its text, so that it answers the same searches as operator==(ListNodeData &, string)
+struct ListNodeDataText{
+	const string &operator()(const ListNodeData &data) const { return data.Text(); }
+};
+//Key extractor on the text as a ListNodeDataKey, so that it answers the same searches as operator==(ListNodeData &, ListNodeDataKey).
+//With USE_STRING_POOL, hash tables keyed on it only hash and compare pointers
+struct ListNodeDataTextKey{
+	ListNodeDataKey operator()(const ListNodeData &data) const { return data.TextKey(); }
+};
+#endif /* ListNodeData_H */
@@ -0,0 +1,120 @@
+/*
+	Yong Wen Chua
+	http://bit.ly/yongwen
+	Released under the LGPL license
+*/
+/*
+	MappedFile maps a whole file into memory, read only. See MappedFile.h
+*/
+#include "MappedFile.h"
+
+//Use of EVIL MACROS to detect Windows, which has its own way of mapping files.
+#ifdef _WIN32
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <unistd.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+#endif
+
+MappedFile::MappedFile(){
+	_data = NULL;
+	_size = 0;
+	#ifdef _WIN32
+		_file = _mapping = NULL;
+	#else
+		_file = -1;
+	#endif
+}
+
+MappedFile::~MappedFile(){
+	Close();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::Open(const char *path){
+	Close();
+	HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (file == INVALID_HANDLE_VALUE){
+		return false;
+	}
+	_file = file;
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size)){
+		Close();
+		return false;
+	}
+	_size = (size_t) size.QuadPart;
+	if (_size == 0){		//Empty files cannot be mapped
+		return true;
+	}
+	_mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (_mapping == NULL){
+		Close();
+		return false;
+	}
+	_data = static_cast<const char *>(MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0));
+	if (_data == NULL){
+		Close();
+		return false;
+	}
+	return true;
+}
+
+void MappedFile::Close(){
+	if (_data != NULL){
+		UnmapViewOfFile(_data);
+	}
+	if (_mapping != NULL){
+		CloseHandle(_mapping);
+	}
+	if (_file != NULL){
+		CloseHandle(_file);
+	}
+	_data = NULL;
+	_size = 0;
+	_file = _mapping = NULL;
+}
+
+#else
+
+bool MappedFile::Open(const char *path){
+	Close();
+	_file = open(path, O_RDONLY);
+	if (_file < 0){
+		return false;
+	}
+	struct stat status;
+	if (fstat(_file, &status) != 0){
+		Close();
+		return false;
+	}
+	_size = (size_t) status.st_size;
+	if (_size == 0){		//Empty files cannot be mapped
+		return true;
+	}
+	void *data = mmap(NULL, _size, PROT_READ, MAP_PRIVATE, _file, 0);
+	if (data == MAP_FAILED){
+		Close();
+		return false;
+	}
+	madvise(data, _size, MADV_SEQUENTIAL);		//The file is read once, from start to end
+	_data = static_cast<const char *>(data);
+	return true;
+}
+
+void MappedFile::Close(){
+	if (_data != NULL){
+		munmap(const_cast<char *>(_data), _size);
+	}
+	if (_file >= 0){
+		close(_file);
+	}
+	_data = NULL;
+	_size = 0;
+	_file = -1;
+}
+
+#endif
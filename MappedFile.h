@@ -0,0 +1,43 @@
+/*
+	Yong Wen Chua
+	http://bit.ly/yongwen
+	Released under the LGPL license
+*/
+/*
+	MappedFile maps a whole file into memory, read only, so that it can be parsed in place without copying it through streams.
+	It uses mmap() on POSIX systems and file mappings on Windows.
+*/
+//These Macros ensure that the file is only #included once.
+#pragma once
+#ifndef MappedFile_H
+#define MappedFile_H
+
+#include <cstddef>
+
+class MappedFile{
+	const char *_data;		//Start of the mapped file. NULL if nothing is mapped
+	size_t _size;			//Size of the file in bytes
+	#ifdef _WIN32
+		void *_file, *_mapping;		//Windows handles
+	#else
+		int _file;					//File descriptor
+	#endif
+
+	//A mapping cannot be shared, so MappedFile cannot be copied.
+	MappedFile(const MappedFile &);
+	MappedFile &operator=(const MappedFile &);
+
+	public:
+		MappedFile();
+		~MappedFile();
+
+		//Maps the file. Returns false if the file cannot be opened or mapped.
+		//An empty file is opened successfully, with Data() returning NULL and Size() returning 0.
+		bool Open(const char *path);
+		void Close();
+
+		const char *Data(){ return _data; }		//Start of the file
+		size_t Size(){ return _size; }			//Size of the file in bytes
+};
+
+#endif /* MappedFile_H */
@@ -0,0 +1,146 @@
+/*
+	Yong Wen Chua
+	http://bit.ly/yongwen
+	Released under the LGPL license
+*/
+/*
+	Node allocation policies for LinkedList.
+
+	An allocator policy hands out and takes back raw, suitably aligned memory for exactly one node of type TNode.
+	Construction and destruction of the node itself is done by LinkedList (see CreateNode() and DestroyNode()).
+	A policy has to implement the following:
+		- void *Allocate()				Returns memory for one node
+		- void Deallocate(void *Memory)	Takes back memory returned by Allocate()
+		- static const bool ReleasesAll	If true, all memory handed out is freed when the allocator is destroyed,
+										so LinkedList does not need to call Deallocate() on every node when it is destroyed.
+
+	HeapNodeAllocator gets every node from the heap, one at a time.
+	SlabNodeAllocator carves nodes out of large contiguous slabs and recycles freed nodes through a free list.
+	The slabs are only returned to the heap when the allocator is destroyed.
+	SequencedNodeAllocator gets nodes from slabs too, and keeps a number in front of each node for the owner of the list,
+	which it can get at through Sequence() without the list knowing.
+*/
+//These Macros ensure that the file is only #included once.
+#pragma once
+#ifndef NodeAllocator_H
+#define NodeAllocator_H
+
+#include <new>
+#include <cstddef>
+#include <type_traits>
+
+template <typename TNode> class HeapNodeAllocator{
+	public:
+		static const bool ReleasesAll = false;
+
+		void *Allocate(){
+			return ::operator new(sizeof(TNode));
+		}
+		void Deallocate(void *Memory){
+			::operator delete(Memory);
+		}
+};
+
+//MaxSlabSize is the maximum number of nodes per slab. Slabs start small and double in size up to MaxSlabSize,
+//so that small lists do not waste memory.
+template <typename TNode, int MaxSlabSize = 4096> class SlabNodeAllocator{
+	//A block is either the storage of a node, or a link in the free list when the node is not in use.
+	//The other members are never used. They are there to give the block the alignment of the most demanding basic types.
+	union Block{
+		char Node[sizeof(TNode)];
+		Block *Next;
+		double _alignDouble;
+		long double _alignLongDouble;
+		long long _alignLongLong;
+	};
+
+	Block *_slabs;				//Chain of slabs. The first block of each slab links to the previous slab
+	Block *_freeList;			//Chain of nodes that have been deallocated
+	Block *_bump, *_bumpEnd;	//Unused blocks at the end of the newest slab
+	int _nextSlabSize;			//Number of blocks in the next slab
+
+	//Slabs cannot be shared, so the allocator cannot be copied.
+	SlabNodeAllocator(const SlabNodeAllocator &);
+	SlabNodeAllocator &operator=(const SlabNodeAllocator &);
+
+	void _NewSlab(){
+		Block *slab = static_cast<Block *>(::operator new(_nextSlabSize * sizeof(Block)));
+		slab -> Next = _slabs;
+		_slabs = slab;
+		_bump = slab + 1;
+		_bumpEnd = slab + _nextSlabSize;
+		if (_nextSlabSize < MaxSlabSize){
+			_nextSlabSize = (_nextSlabSize * 2 < MaxSlabSize) ? _nextSlabSize * 2 : MaxSlabSize;
+		}
+	}
+
+	public:
+		static const bool ReleasesAll = true;
+
+		SlabNodeAllocator(){
+			_slabs = _freeList = _bump = _bumpEnd = NULL;
+			_nextSlabSize = (MaxSlabSize < 32) ? MaxSlabSize : 32;
+			if (_nextSlabSize < 2){		//The first block of each slab is used as the link to the previous slab
+				_nextSlabSize = 2;
+			}
+		}
+		~SlabNodeAllocator(){
+			Block *next;
+			while (_slabs != NULL){
+				next = _slabs -> Next;
+				::operator delete(_slabs);
+				_slabs = next;
+			}
+		}
+
+		void *Allocate(){
+			Block *block;
+			if (_freeList != NULL){		//Recycle a freed node first
+				block = _freeList;
+				_freeList = block -> Next;
+				return block;
+			}
+			if (_bump == _bumpEnd){
+				_NewSlab();
+			}
+			block = _bump++;
+			return block;
+		}
+		void Deallocate(void *Memory){
+			Block *block = static_cast<Block *>(Memory);
+			block -> Next = _freeList;
+			_freeList = block;
+		}
+};
+
+//The number of a node is 0 when it is allocated. ShardedLinkedList numbers its nodes in the order of its whole list this way.
+template <typename TNode, int MaxSlabSize = 4096> class SequencedNodeAllocator{
+	struct Block{
+		long long Sequence;
+		typename std::aligned_storage<sizeof(TNode), std::alignment_of<TNode>::value>::type Node;
+	};
+	SlabNodeAllocator<Block, MaxSlabSize> _blocks;
+
+	static Block *_BlockOf(void *Memory){
+		return reinterpret_cast<Block *>(static_cast<char *>(Memory) - offsetof(Block, Node));
+	}
+
+	public:
+		static const bool ReleasesAll = SlabNodeAllocator<Block, MaxSlabSize>::ReleasesAll;
+
+		void *Allocate(){
+			Block *block = static_cast<Block *>(_blocks.Allocate());
+			block -> Sequence = 0;
+			return &block -> Node;
+		}
+		void Deallocate(void *Memory){
+			_blocks.Deallocate(_BlockOf(Memory));
+		}
+
+		//The number kept with Node, which must have been allocated by a SequencedNodeAllocator<TNode>
+		static long long &Sequence(TNode *Node){
+			return _BlockOf(Node) -> Sequence;
+		}
+};
+
+#endif /* NodeAllocator_H */
@@ -6,17 +6,28 @@
 /*
 	This file contains the operation procedures to deal with the command file and date files.
 */
+#include <cstring>
+#include <climits>
+#include <cstdio>
+#include <cstdint>
+#include <vector>
+#include <iterator>
 #include "Operation.h"
 #include "List.h"
 #include "ListNodeData.h"
+#include "MappedFile.h"
+#include "OutputWriter.h"
 using namespace std;
 
 //Global Variable
-extern LinkedList<ListNodeData>  TheList;
-extern ifstream CommandFile, DataFile;
-extern ofstream OutputFile;
+extern DataList  TheList;
+extern ifstream CommandFile;
+extern OutputWriter OutputFile;
 extern string FileNumber;
 
+vector<ListNodeData> PendingInserts;		//Inserts queued by QueueInsert()
+vector<string> PendingDeletes;				//Deletes queued by QueueDelete()
+
 istream& GetLine(istream& is, string& str){		//This function removes the \r carriage return if a Unix system is detected.
 	//Doing code that needs to work across platforms IS difficult.
 	str = "";	
@@ -43,57 +54,152 @@ istream& GetLine(istream& is, string& str){		//This function removes the \r carr
 
 void OpenOutputFile(){
 	static string _FileNumber = "";
-	if (!OutputFile.is_open() || _FileNumber != FileNumber){
+	if (!OutputFile.IsOpen() || _FileNumber != FileNumber){
 		_FileNumber = FileNumber;
-		if (OutputFile.is_open()){
-			OutputFile.close();
-		}
+		OutputFile.Close();			//Flushes whatever was written for the previous file
 		string file = "output_" + FileNumber + ".txt";
 		cout << "Opening output file...";
-		OutputFile.open(file.c_str(), ios::ate | ios::app | ios::out);
-		if (!OutputFile){
+		if (!OutputFile.Open(file.c_str())){
 			TerminateError("Unable to open output file.");
 		}
 	}
 }
 
+//Returns the next line from cursor, without its newline or carriage return, and moves cursor to the start of the line after it.
+//memchr() is used to look for the newline, as the C library vectorises it.
+static const char *NextLine(const char *&cursor, const char *end, size_t &length){
+	const char *line = cursor;
+	const char *newline = static_cast<const char *>(memchr(cursor, '\n', end - cursor));
+	if (newline == NULL){
+		length = end - line;
+		cursor = end;
+	}
+	else{
+		length = newline - line;
+		cursor = newline + 1;
+	}
+	if (length > 0 && line[length - 1] == '\r'){
+		length--;
+	}
+	return line;
+}
+
+//Moves cursor past whitespace, even across lines, as operator>> does
+static void SkipSpace(const char *&cursor, const char *end){
+	while (cursor < end && (*cursor == ' ' || *cursor == '\t' || *cursor == '\r' || *cursor == '\n' || *cursor == '\v' || *cursor == '\f')){
+		cursor++;
+	}
+}
+
+//Parses an integer at cursor, with an optional sign, and moves cursor past it. Whitespace before it is skipped.
+//Returns false if there is no number there: the end was reached, no digit was found, or the number does not fit in an int.
+static bool ParseInt(const char *&cursor, const char *end, int &number){
+	SkipSpace(cursor, end);
+	bool negative = false;
+	if (cursor < end && (*cursor == '-' || *cursor == '+')){
+		negative = (*cursor == '-');
+		cursor++;
+	}
+	const long long limit = negative ? -(long long) INT_MIN : INT_MAX;
+	long long value = 0;
+	bool digits = false, fits = true;
+	while (cursor < end && *cursor >= '0' && *cursor <= '9'){
+		if (fits){
+			value = value * 10 + (*cursor - '0');
+			fits = (value <= limit);
+		}
+		digits = true;
+		cursor++;
+	}
+	if (!digits || !fits){
+		return false;
+	}
+	number = (int) (negative ? -value : value);
+	return true;
+}
+
 void ReadDataFile(){
 	cout << "Opening data file 'data_" << FileNumber << ".txt'..." << endl;
 	string file = "data_" + FileNumber + ".txt";
-	DataFile.open(file.c_str());
-	if (!DataFile){
+	MappedFile DataFile;		//The data file is mapped into memory and parsed in place, in one pass
+	if (!DataFile.Open(file.c_str())){
 		TerminateError("Unable to open data file.");
 	}
-	ListNode<ListNodeData> *node = NULL;
-	//Find the last node to append the list, if the list is already with items. 
-	TheList.Rewind();
-	while (TheList.Current() != NULL){
-		node = TheList.Current();
-		TheList.Next();
-	}
-	string text, dummy;
-	int number;
-	//Read data file into list
-	while (!DataFile.eof()){
-		GetLine(DataFile, text);		//GetLine gets rid of newline character.
-		if (DataFile.eof()){			//EOF was reached before a number is read!? Means file is malformed. Ignoring final node.
+	const char *cursor = DataFile.Data(), *end = cursor + DataFile.Size();
+	const char *text;
+	size_t length, rest;
+	int number, count = 0;
+	//Read data file into list. Each record is a line of text followed by a number. Empty lines are ignored.
+	while (cursor < end){
+		text = NextLine(cursor, end, length);
+		if (length == 0){
+			continue;
+		}
+		SkipSpace(cursor, end);
+		if (cursor == end){		//EOF was reached before a number is read!? Means file is malformed. Ignoring final node.
 			cout << "Unexpected end of file for data file. Finishing read." << endl;
 			break;
 		}
-		DataFile >> number;
-		getline(DataFile, dummy);	//Use GetLine to clear the newline character.
-		//The default behaviour of inserting new nodes to the list is by inserting it at the first node.
-		//So we need a "workaround" to build the list as it was defined in the data file.
-		cout << "Appending Node " << text << " " << number << endl;
-		if (node == NULL){
-			node = TheList.InsertNewNode(ListNodeData(number, text));		//This is the first node.
+		if (!ParseInt(cursor, end, number)){
+			cout << "Invalid number for '" << string(text, length) << "'. Ignoring node." << endl;
+			NextLine(cursor, end, rest);
+			continue;
 		}
-		else{
-			node = TheList.AppendNode(node, ListNodeData(number, text));	//Append additional node behind the first node
+		NextLine(cursor, end, rest);		//Discard the rest of the line with the number
+		//Append at the tail so that the list is built as it was defined in the data file.
+		//The text is copied once, straight from the mapping into the node.
+		TheList.EmplaceBack(number, text, length);
+		count++;
+	}
+	cout << "Appended " << count << " nodes." << endl;
+}
+
+void QueueInsert(int number, string &text){
+	PendingInserts.push_back(ListNodeData(number, std::move(text)));		//The text is moved. GetLine() refills it
+}
+
+bool FlushInserts(){
+	if (PendingInserts.empty()){
+		return false;
+	}
+	//The queue is cleared straight after, so the records are moved into the list rather than copied
+	TheList.InsertOrderedBatch(make_move_iterator(PendingInserts.begin()), make_move_iterator(PendingInserts.end()));
+	PendingInserts.clear();
+	return true;
+}
+
+void QueueDelete(string &search){
+	PendingDeletes.push_back(search);
+}
+
+//Makes the keys to delete texts by (see DataKey in Operation.h). Each text is looked up in the pool once, here, and the
+//batch only compares pointers after that.
+template <typename TKey> struct DeleteKeys{
+	static const vector<TKey> &Of(const vector<string> &texts, vector<TKey> &keys){
+		keys.reserve(texts.size());
+		for (size_t i = 0; i < texts.size(); i++){
+			keys.push_back(ListNodeData::Key(texts[i]));
 		}
-		
+		return keys;
 	}
-	DataFile.close();
+};
+//Strings are their own keys
+template <> struct DeleteKeys<string>{
+	static const vector<string> &Of(const vector<string> &texts, vector<string> &){ return texts; }
+};
+
+bool FlushDeletes(){
+	if (PendingDeletes.empty()){
+		return false;
+	}
+	vector<int> counts(PendingDeletes.size(), 1), deleted;		//Each command deletes one node
+	vector<DataKey> keys;
+	TheList.DeleteNodesBatch(DeleteKeys<DataKey>::Of(PendingDeletes, keys), counts, deleted, DataKeyOf());
+	for (size_t i = 0; i < PendingDeletes.size(); i++){
+		cout << "Deleting node " << PendingDeletes[i] << "... " << (deleted[i] == 1 ? "Deleted." : "Not found.") << endl;
+	}
+	PendingDeletes.clear();
+	return true;
 }
 
 void DumpFile(){
@@ -102,46 +208,125 @@ void DumpFile(){
 	TheList.Rewind();
 	cout << "Dumping file... ";
 	while(TheList.Current() != NULL){
-		OutputFile << TheList.Current()->Data().Text() << endl << TheList.Current()->Data().Number() << endl;
+		OutputFile << TheList.Current()->Data().Text() << '\n' << TheList.Current()->Data().Number() << '\n';
 		TheList.Next();
 	}
+	OutputFile.Flush();			//Output is only flushed once per command
 	cout << " Dumped." << endl;
 	
 }
 
 void DumpAverage(){
 	cout << "Calculating average... ";
-	double sum = 0, count = 0;
-	//Traverse the list
-	TheList.Rewind();
-	while (TheList.Current() != NULL){
-		count ++;
-		sum += TheList.Current() -> Data().Number();
-		TheList.Next();
-	}
+	double sum = (double) TheList.Sum(), count = TheList.Length();		//Kept up to date by the list. No need to traverse it
 	double average = sum/count;
 
 	cout << showpoint << average << " Dumping to file...";
 	//Estabilish Output File
 	OpenOutputFile();
-	OutputFile << "Average Value: " << dec << average << endl;
+	OutputFile << "Average Value: " << average << '\n';
+	OutputFile.Flush();
 	cout << " Dumped." << endl;
 }
 
 void DumpMax(){
 	cout << "Determining maximum... ";
-	int max = 0;
-	//Traverse the list
-	TheList.Rewind();
-	while (TheList.Current() != NULL){
-		max = (TheList.Current() -> Data().Number() > max) ? TheList.Current() -> Data().Number() : max;
-		TheList.Next();
-	}
+	int max = TheList.Max();		//0 if the list is empty
 
 	cout << max << " Dumping to file...";
 	//Estabilish Output File
 	OpenOutputFile();
-	OutputFile << "Maximum Value: " << dec << max << endl;
+	OutputFile << "Maximum Value: " << max << '\n';
+	OutputFile.Flush();
 	cout << " Dumped." << endl;
-	OutputFile.close();
+}
+
+/*
+	Snapshots
+
+	A snapshot holds the nodes of the list in a binary form that can be loaded without parsing any text.
+	All values are written in the byte order of the machine, so a snapshot can only be loaded on the kind of machine that saved it.
+		- Header: the magic bytes "LLSN", then the version, the sort status and the number of nodes, as uint32
+		- The numbers of the nodes, as packed int32
+		- The texts of the nodes, each as a uint32 length followed by the characters, without a terminator
+*/
+static const char SnapshotMagic[4] = { 'L', 'L', 'S', 'N' };
+static const uint32_t SnapshotVersion = 1;
+
+void WriteSnapshot(){
+	string file = "snapshot_" + FileNumber + ".bin";
+	cout << "Writing snapshot '" << file << "'... ";
+	FILE *snapshot = fopen(file.c_str(), "wb");
+	if (snapshot == NULL){
+		TerminateError("Unable to open snapshot file.");
+	}
+	vector<int32_t> numbers;
+	numbers.reserve(TheList.Length());
+	for (TheList.Rewind(); TheList.Current() != NULL; TheList.Next()){
+		numbers.push_back(TheList.Current() -> Data().Number());
+	}
+	uint32_t header[3] = { SnapshotVersion, (uint32_t) TheList.GetSortStatus(), (uint32_t) numbers.size() };
+	bool written = (fwrite(SnapshotMagic, sizeof(SnapshotMagic), 1, snapshot) == 1);
+	written = written && (fwrite(header, sizeof(header), 1, snapshot) == 1);
+	if (!numbers.empty()){
+		written = written && (fwrite(&numbers[0], sizeof(int32_t), numbers.size(), snapshot) == numbers.size());
+	}
+	//The string table. fwrite() buffers, so writing each text on its own is cheap
+	for (TheList.Rewind(); written && TheList.Current() != NULL; TheList.Next()){
+		const string &text = TheList.Current() -> Data().Text();
+		uint32_t length = (uint32_t) text.length();
+		written = (fwrite(&length, sizeof(length), 1, snapshot) == 1) && (fwrite(text.data(), 1, length, snapshot) == length);
+	}
+	TheList.Rewind();
+	if (fclose(snapshot) != 0 || !written){
+		TerminateError("Unable to write snapshot file.");
+	}
+	cout << "Wrote " << numbers.size() << " nodes." << endl;
+}
+
+void ReadSnapshot(){
+	string file = "snapshot_" + FileNumber + ".bin";
+	cout << "Loading snapshot '" << file << "'... ";
+	MappedFile snapshot;		//The snapshot is mapped into memory and the nodes are created straight from it
+	if (!snapshot.Open(file.c_str())){
+		TerminateError("Unable to open snapshot file.");
+	}
+	const char *cursor = snapshot.Data(), *end = cursor + snapshot.Size();
+	uint32_t header[3];
+	if (snapshot.Size() < sizeof(SnapshotMagic) + sizeof(header) || memcmp(cursor, SnapshotMagic, sizeof(SnapshotMagic)) != 0){
+		TerminateError("Not a snapshot file.");
+	}
+	cursor += sizeof(SnapshotMagic);
+	memcpy(header, cursor, sizeof(header));		//The mapping is aligned, but copying avoids assuming so
+	cursor += sizeof(header);
+	if (header[0] != SnapshotVersion){
+		TerminateError("Unsupported snapshot version.");
+	}
+	uint32_t count = header[2];
+	if (header[1] > (uint32_t) Descending || count > (size_t) (end - cursor) / sizeof(int32_t)){
+		TerminateError("Snapshot file is corrupted.");
+	}
+	const char *numbers = cursor;
+	cursor += count * sizeof(int32_t);
+	bool wasEmpty = (TheList.Length() == 0);
+	int32_t number;
+	uint32_t length;
+	for (uint32_t i = 0; i < count; i++){
+		if ((size_t) (end - cursor) < sizeof(length)){
+			TerminateError("Snapshot file is corrupted.");
+		}
+		memcpy(&length, cursor, sizeof(length));
+		cursor += sizeof(length);
+		if ((size_t) (end - cursor) < length){
+			TerminateError("Snapshot file is corrupted.");
+		}
+		memcpy(&number, numbers + i * sizeof(int32_t), sizeof(number));
+		TheList.EmplaceBack(number, cursor, (size_t) length);
+		cursor += length;
+	}
+	//The nodes come back in the order they were saved in. If nothing was in the list before, that order still holds.
+	if (wasEmpty){
+		TheList.SetSortStatus((SortOrder) header[1]);
+	}
+	cout << "Appended " << count << " nodes." << endl;
 }
\ No newline at end of file
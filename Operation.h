@@ -17,9 +17,55 @@
 #include <string>
 //#include <cstring>
 #include <iomanip>
+#include <vector>
+#include "List.h"
+#include "HashIndex.h"
+#include "ListNodeData.h"
+#include "ShardedLinkedList.h"
+#include "DoublyLinkedList.h"
+#include "ColumnarList.h"
+#include "Instrumentation.h"
 
 using namespace std;
 
+//The container used for the list. Define USE_UNROLLED_LIST at compile time to use UnrolledLinkedList instead of LinkedList,
+//or USE_SHARDED_LIST to spread the nodes over several LinkedLists by their text, which are worked on in parallel,
+//or USE_DOUBLY_LINKED_LIST to use DoublyLinkedList, which unlinks the nodes found by the hash index without a walk,
+//or USE_COLUMNAR_LIST to use ColumnarList, which keeps the numbers and the texts in separate arrays.
+//Define USE_INSTRUMENTATION at compile time to count the work LinkedList and DoublyLinkedList do, and to time each command of the command file.
+//See Instrumentation.h
+#if defined(USE_INSTRUMENTATION)
+typedef OperationCounters ListInstrumentation;
+typedef CommandLatencies CommandTimes;
+#else
+typedef NoInstrumentation ListInstrumentation;
+typedef NoCommandLatencies CommandTimes;
+#endif
+//What the hash indexes and deletes key the nodes on. With USE_STRING_POOL, the texts as ListNodeDataKeys, which are hashed and
+//compared by pointer. ColumnarList keeps texts of its own, so it always deletes by string.
+#if defined(USE_STRING_POOL) && !defined(USE_COLUMNAR_LIST)
+typedef ListNodeDataKey DataKey;
+typedef ListNodeDataTextKey DataKeyOf;
+#else
+typedef string DataKey;
+typedef ListNodeDataText DataKeyOf;
+#endif
+typedef LinkedList<ListNodeData, SlabNodeAllocator<ListNode<ListNodeData> >, HashIndex<ListNodeData, DataKey, DataKeyOf>, ListAggregates<ListNodeData>,
+	IntKeyOf<ListNodeData>, KeyLess, ListInstrumentation> DataShard;
+#if defined(USE_UNROLLED_LIST)
+typedef UnrolledLinkedList<ListNodeData, 16> DataList;
+#elif defined(USE_SHARDED_LIST)
+typedef ShardedLinkedList<ListNodeData, DataKey, DataKeyOf, 8, LinkedList<ListNodeData, SequencedNodeAllocator<ListNode<ListNodeData> >,
+	HashIndex<ListNodeData, DataKey, DataKeyOf>, ListAggregates<ListNodeData>, IntKeyOf<ListNodeData>, KeyLess, ListInstrumentation> > DataList;
+#elif defined(USE_DOUBLY_LINKED_LIST)
+typedef DoublyLinkedList<ListNodeData, SlabNodeAllocator<DoublyListNode<ListNodeData> >, HashIndex<ListNodeData, DataKey, DataKeyOf>, ListAggregates<ListNodeData>,
+	IntKeyOf<ListNodeData>, KeyLess, ListInstrumentation> DataList;
+#elif defined(USE_COLUMNAR_LIST)
+typedef ColumnarList DataList;
+#else
+typedef DataShard DataList;
+#endif
+
 //Function Prototypes
 
 //"Overloaded" version of GetLine() to deal with carriage return \r
@@ -34,5 +80,11 @@ void ReadDataFile();	//Read data file
 void DumpFile();		//Dump list data to file
 void DumpAverage();		//Dump average
 void DumpMax();			//Dump max
+void QueueInsert(int number, string &text);		//Queue a node to insert. Consecutive inserts are done as one batch
+bool FlushInserts();	//Insert the queued nodes. Returns false if there were none
+void QueueDelete(string &search);		//Queue a node to delete. Consecutive deletes are done as one batch
+bool FlushDeletes();	//Delete the queued nodes and report on each of them. Returns false if there were none
+void WriteSnapshot();	//Save the list to a binary snapshot file
+void ReadSnapshot();	//Append the nodes in a binary snapshot file to the list
 
 #endif /* Operation_H */
\ No newline at end of file
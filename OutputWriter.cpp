@@ -0,0 +1,103 @@
+/*
+	Yong Wen Chua
+	http://bit.ly/yongwen
+	Released under the LGPL license
+*/
+/*
+	OutputWriter writes text to a file through a large buffer of its own. See OutputWriter.h
+*/
+#include <cstring>
+#include "OutputWriter.h"
+
+//Pairs of digits, from "00" to "99". Used to convert integers to text two digits at a time.
+static const char Digits[] =
+	"00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+	"40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+	"8081828384858687888990919293949596979899";
+
+OutputWriter::OutputWriter(){
+	_file = NULL;
+	_buffer = new char[BufferSize];
+	_used = 0;
+}
+
+OutputWriter::~OutputWriter(){
+	Close();
+	delete [] _buffer;
+}
+
+bool OutputWriter::Open(const char *path){
+	Close();
+	_file = fopen(path, "a");
+	if (_file == NULL){
+		return false;
+	}
+	setvbuf(_file, NULL, _IONBF, 0);		//The buffer is ours. Let every fwrite() go straight to the operating system
+	return true;
+}
+
+void OutputWriter::Close(){
+	if (_file == NULL){
+		return;
+	}
+	Flush();
+	fclose(_file);
+	_file = NULL;
+}
+
+void OutputWriter::Flush(){
+	if (_file != NULL && _used > 0){
+		fwrite(_buffer, 1, _used, _file);
+	}
+	_used = 0;
+}
+
+void OutputWriter::Write(const char *text, size_t length){
+	if (length > BufferSize){		//Too large to buffer. Write it out directly
+		Flush();
+		if (_file != NULL){
+			fwrite(text, 1, length, _file);
+		}
+		return;
+	}
+	_Reserve(length);
+	memcpy(_buffer + _used, text, length);
+	_used += length;
+}
+
+OutputWriter &OutputWriter::operator<<(const char *text){
+	Write(text, strlen(text));
+	return *this;
+}
+
+OutputWriter &OutputWriter::operator<<(int number){
+	char text[12];			//Enough for the sign and 10 digits
+	char *end = text + sizeof(text), *start = end;
+	//Work with the magnitude as unsigned, so that the most negative int does not overflow
+	unsigned int value = (number < 0) ? 0u - (unsigned int) number : (unsigned int) number;
+	while (value >= 100){
+		unsigned int pair = (value % 100) * 2;
+		value /= 100;
+		*--start = Digits[pair + 1];
+		*--start = Digits[pair];
+	}
+	if (value >= 10){
+		*--start = Digits[value * 2 + 1];
+		*--start = Digits[value * 2];
+	}
+	else{
+		*--start = (char) ('0' + value);
+	}
+	if (number < 0){
+		*--start = '-';
+	}
+	Write(start, end - start);
+	return *this;
+}
+
+OutputWriter &OutputWriter::operator<<(double number){
+	char text[32];
+	int length = snprintf(text, sizeof(text), "%g", number);		//Same as the default formatting of ofstream
+	Write(text, (size_t) length);
+	return *this;
+}
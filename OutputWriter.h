@@ -0,0 +1,66 @@
+/*
+	Yong Wen Chua
+	http://bit.ly/yongwen
+	Released under the LGPL license
+*/
+/*
+	OutputWriter writes text to a file through a large buffer of its own.
+	Text and numbers are formatted straight into the buffer, and the buffer is handed to the operating system in one write
+	only when it is full, when Flush() is called, or when the file is closed. Nothing is flushed at the end of each line.
+
+	The file is opened in text mode, so that new lines are written the same way as with ofstream.
+*/
+//These Macros ensure that the file is only #included once.
+#pragma once
+#ifndef OutputWriter_H
+#define OutputWriter_H
+
+#include <cstdio>
+#include <cstddef>
+#include <string>
+
+class OutputWriter{
+	static const size_t BufferSize = 1 << 20;
+
+	FILE *_file;
+	char *_buffer;
+	size_t _used;			//Number of bytes in the buffer
+
+	//Makes sure there is room for length more bytes in the buffer
+	void _Reserve(size_t length){
+		if (_used + length > BufferSize){
+			Flush();
+		}
+	}
+
+	//A file cannot be shared, so OutputWriter cannot be copied.
+	OutputWriter(const OutputWriter &);
+	OutputWriter &operator=(const OutputWriter &);
+
+	public:
+		OutputWriter();
+		~OutputWriter();		//Flushes and closes the file
+
+		bool Open(const char *path);		//Opens the file for appending. Returns false on failure
+		void Close();						//Flushes and closes the file
+		bool IsOpen(){ return (_file != NULL); }
+		void Flush();						//Writes out whatever is in the buffer
+
+		void Write(const char *text, size_t length);
+
+		//Formatting. Numbers are formatted the same way as ofstream does by default
+		OutputWriter &operator<<(const std::string &text){
+			Write(text.data(), text.length());
+			return *this;
+		}
+		OutputWriter &operator<<(const char *text);
+		OutputWriter &operator<<(char character){
+			_Reserve(1);
+			_buffer[_used++] = character;
+			return *this;
+		}
+		OutputWriter &operator<<(int number);
+		OutputWriter &operator<<(double number);
+};
+
+#endif /* OutputWriter_H */
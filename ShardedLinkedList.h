@@ -0,0 +1,406 @@
+/*
+	Yong Wen Chua
+	http://bit.ly/yongwen
+	Released under the LGPL license
+*/
+/*
+	ShardedLinkedList spreads its nodes over Shards independent lists of type TList, picking the list (the shard) for each
+	node by hashing its key, as returned by the functor TKeyOf. All nodes with the same key are in the same shard, so
+	a search or a delete by key only has to look at one shard.
+
+	Each shard has its own lock, so different threads can work on different shards at the same time. Batches of inserts
+	and deletes are split by shard, and the shards are worked on in parallel on a thread pool.
+	Operations on the whole list (Sort(), Reverse(), Sum(), Min(), Max()) are run on every shard in parallel, and the
+	results are then merged.
+
+	Iterating with Rewind(), Current() and Next() visits the nodes of all shards in the order one LinkedList would have
+	them in after the same calls. To know that order, every node is numbered, through the allocator of the shards, which
+	has to be a SequencedNodeAllocator (see NodeAllocator.h). A node inserted at the front of the list, or before the nodes
+	with the same value in an ordered list, gets a number lower than all others, and a node pushed to the back a number
+	higher than all others. The shards are then merged by their numbers if the list is unordered, and by their int() value
+	if it is ordered, with nodes of equal value in the order of their numbers. Sort() is stable, so it keeps the order of
+	the numbers, and Reverse() turns the order of the numbers around instead of renumbering the nodes. A list that becomes
+	unordered is renumbered in the order it was in.
+	Iteration and the whole-list operations must not overlap with changes from other threads.
+*/
+//These Macros ensure that the file is only #included once.
+#pragma once
+#ifndef ShardedLinkedList_H
+#define ShardedLinkedList_H
+
+#include <cstddef>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <type_traits>
+#include <utility>
+#include <functional>
+#include "List.h"
+#include "ThreadPool.h"
+
+//True if the shards of type TList keep numbers for ShardedLinkedList
+template <typename TList> struct NumbersNodes : std::false_type{};
+template <typename TData, typename THashIndex, typename TAggregates, typename TKeyOf, typename TCompare, typename TInstrumentation>
+	struct NumbersNodes<LinkedList<TData, SequencedNodeAllocator<ListNode<TData> >, THashIndex, TAggregates, TKeyOf, TCompare, TInstrumentation> > : std::true_type{};
+
+template <typename TData, typename TKey, typename TKeyOf, int Shards = 8, typename TList = LinkedList<TData, SequencedNodeAllocator<ListNode<TData> > > > class ShardedLinkedList{
+	static_assert(NumbersNodes<TList>::value, "The shards of a ShardedLinkedList have to allocate their nodes with SequencedNodeAllocator");
+
+	struct Shard{
+		TList List;
+		SpinLock Lock;
+	};
+
+	Shard _shards[Shards];
+	ThreadPool _pool;
+	TKeyOf _keyOf;
+	std::hash<TKey> _hash;
+	ListNode<TData> *_cursors[Shards];		//Internal pointer of each shard
+	int _currentShard;						//Shard of the current node. Shards if past the last node
+	std::atomic<long long> _lowest, _highest;	//Lowest and highest numbers given to nodes so far
+	bool _reversed;							//The nodes are in the order of their numbers from the highest down
+
+	int _ShardOf(const TKey &key){ return (int) (_hash(key) % Shards); }
+	int _ShardOf(const TData &data){ return _ShardOf(_keyOf(data)); }
+	static long long &_Sequence(ListNode<TData> *node){ return SequencedNodeAllocator<ListNode<TData> >::Sequence(node); }
+	//Numbers for a node that goes before and after all other nodes
+	long long _FrontSequence(){ return _reversed ? ++_highest : --_lowest; }
+	long long _BackSequence(){ return _reversed ? --_lowest : ++_highest; }
+	bool _Before(ListNode<TData> *a, ListNode<TData> *b);		//Returns true if node a comes before node b in the list
+	void _PickCurrent();			//Sets _currentShard to the shard whose internal pointer is the next node to visit
+	void _Renumber();				//Numbers the nodes from 1 in the order they are in now. Calls Rewind()
+	void _SetAllSortStatus(SortOrder SortBy);
+
+	//Lists own their nodes, so they cannot be copied
+	ShardedLinkedList(const ShardedLinkedList &);
+	ShardedLinkedList &operator=(const ShardedLinkedList &);
+
+	public:
+		//threads is the number of threads to work on the shards with. 0 uses one per hardware thread.
+		ShardedLinkedList(int threads = 0);
+
+		/*
+			Retrieving Methods
+		*/
+		int Length();
+		long long Sum();
+		int Min();			//0 if the list is empty
+		int Max();			//0 if the list is empty
+
+		/*
+			Iteration Methods. See above for the order the nodes are visited in
+		*/
+		void Rewind();
+		ListNode<TData> *Next();
+		ListNode<TData> *Current();
+
+		/*
+			Modifying Methods. These behave like the ones in LinkedList, on the shard the data belongs to.
+			They can be called from several threads at once.
+		*/
+		ListNode<TData> *InsertNewNodeOrdered(TData data);
+		template <typename... TArgs> ListNode<TData> *EmplaceNewNodeOrdered(TArgs&&... args){
+			return InsertNewNodeOrdered(TData(std::forward<TArgs>(args)...));
+		}
+		ListNode<TData> *PushBack(TData data);		//Appends to the back of the shard. Sets SortStatus to Unordered
+		template <typename... TArgs> ListNode<TData> *EmplaceBack(TArgs&&... args){
+			return PushBack(TData(std::forward<TArgs>(args)...));
+		}
+		int DeleteNode(const TKey &key, int n = -1);		//Deletes the first n nodes with key. -1 deletes all of them
+		void Clear();		//Destroys every node of every shard. The list is left empty and Unordered
+
+		/*
+			Batches. The shards are worked on in parallel
+		*/
+		//Inserts the records in [first, last) in order. The records are copied, or moved with std::move_iterators, as in LinkedList.
+		template <typename TIterator> void InsertOrderedBatch(TIterator first, TIterator last);
+		//For each i, deletes the first counts[i] nodes with keys[i] (all of them if counts[i] is -1), as if DeleteNode()
+		//was called for each key in turn. The number of nodes deleted for each key is put in deleted[i]. Returns the total.
+		//keyOf is there to match LinkedList::DeleteNodesBatch(). The shards always use their own TKeyOf.
+		int DeleteNodesBatch(const std::vector<TKey> &keys, const std::vector<int> &counts, std::vector<int> &deleted, TKeyOf keyOf = TKeyOf());
+
+		/*
+			Sort Related
+		*/
+		void Reverse();
+		SortOrder GetSortStatus(){ return _SortStatus; }
+		void SetSortStatus(SortOrder SortBy);
+		void Sort(SortOrder SortBy = Ascending);		//Implicitly calls Rewind(). Changes SortStatus
+
+		void EnableIndex(bool enable = true);		//See LinkedList::EnableIndex()
+
+	protected:
+		SortOrder _SortStatus;			//Stores the sort status of the list
+};
+
+/*
+	Constructor
+*/
+template <typename TData, typename TKey, typename TKeyOf, int Shards, typename TList> ShardedLinkedList<TData, TKey, TKeyOf, Shards, TList>::ShardedLinkedList(int threads) : _pool(threads), _lowest(0), _highest(0){
+	_SortStatus = Unordered;
+	_reversed = false;
+	for (int i = 0; i < Shards; i++){
+		_shards[i].List.SetSortThreads(1);		//The shards are already sorted in parallel with each other
+	}
+	Rewind();
+}
+
+/*
+	Helper Methods
+*/
+//_Before()
+template <typename TData, typename TKey, typename TKeyOf, int Shards, typename TList> bool ShardedLinkedList<TData, TKey, TKeyOf, Shards, TList>::_Before(ListNode<TData> *a, ListNode<TData> *b){
+	if (_SortStatus != Unordered){
+		int keyA = (int) a -> Data(), keyB = (int) b -> Data();
+		if (keyA != keyB){
+			return (_SortStatus == Ascending) ? (keyA < keyB) : (keyA > keyB);
+		}
+	}
+	return _reversed ? (_Sequence(a) > _Sequence(b)) : (_Sequence(a) < _Sequence(b));
+}
+//_PickCurrent()
+template <typename TData, typename TKey, typename TKeyOf, int Shards, typename TList> void ShardedLinkedList<TData, TKey, TKeyOf, Shards, TList>::_PickCurrent(){
+	_currentShard = Shards;
+	for (int i = 0; i < Shards; i++){
+		if (_cursors[i] != NULL && (_currentShard == Shards || _Before(_cursors[i], _cursors[_currentShard]))){
+			_currentShard = i;
+		}
+	}
+}
+//_Renumber()
+//Only the nodes at the internal pointers are compared while picking the next node, so the nodes already visited can be
+//renumbered on the way.
+template <typename TData, typename TKey, typename TKeyOf, int Shards, typename TList> void ShardedLinkedList<TData, TKey, TKeyOf, Shards, TList>::_Renumber(){
+	long long sequence = 0;
+	for (Rewind(); Current() != NULL; Next()){
+		_Sequence(Current()) = ++sequence;
+	}
+	_lowest = 1;
+	_highest = sequence;
+	_reversed = false;
+	Rewind();
+}
+//_SetAllSortStatus()
+//An ordered list is not in the order of the numbers of its nodes, so they are renumbered when it becomes unordered
+template <typename TData, typename TKey, typename TKeyOf, int Shards, typename TList> void ShardedLinkedList<TData, TKey, TKeyOf, Shards, TList>::_SetAllSortStatus(SortOrder SortBy){
+	if (SortBy == Unordered && _SortStatus != Unordered){
+		_Renumber();
+	}
+	for (int i = 0; i < Shards; i++){
+		std::lock_guard<SpinLock> lock(_shards[i].Lock);
+		_shards[i].List.SetSortStatus(SortBy);
+	}
+	_SortStatus = SortBy;
+}
+
+/*
+	Retrieving Methods
+*/
+//Length()
+template <typename TData, typename TKey, typename TKeyOf, int Shards, typename TList> int ShardedLinkedList<TData, TKey, TKeyOf, Shards, TList>::Length(){
+	int length = 0;
+	for (int i = 0; i < Shards; i++){
+		length += _shards[i].List.Length();
+	}
+	return length;
+}
+//Sum()
+template <typename TData, typename TKey, typename TKeyOf, int Shards, typename TList> long long ShardedLinkedList<TData, TKey, TKeyOf, Shards, TList>::Sum(){
+	long long sums[Shards];
+	_pool.Run(Shards, [&](int shard){ sums[shard] = _shards[shard].List.Sum(); });
+	long long sum = 0;
+	for (int i = 0; i < Shards; i++){
+		sum += sums[i];
+	}
+	return sum;
+}
+//Min()
+template <typename TData, typename TKey, typename TKeyOf, int Shards, typename TList> int ShardedLinkedList<TData, TKey, TKeyOf, Shards, TList>::Min(){
+	int mins[Shards];
+	_pool.Run(Shards, [&](int shard){ mins[shard] = _shards[shard].List.Min(); });
+	bool found = false;
+	int min = 0;
+	for (int i = 0; i < Shards; i++){
+		if (_shards[i].List.Length() > 0 && (!found || mins[i] < min)){		//Empty shards report 0, which must not count
+			min = mins[i];
+			found = true;
+		}
+	}
+	return min;
+}
+//Max()
+template <typename TData, typename TKey, typename TKeyOf, int Shards, typename TList> int ShardedLinkedList<TData, TKey, TKeyOf, Shards, TList>::Max(){
+	int maxes[Shards];
+	_pool.Run(Shards, [&](int shard){ maxes[shard] = _shards[shard].List.Max(); });
+	bool found = false;
+	int max = 0;
+	for (int i = 0; i < Shards; i++){
+		if (_shards[i].List.Length() > 0 && (!found || maxes[i] > max)){
+			max = maxes[i];
+			found = true;
+		}
+	}
+	return max;
+}
+
+/*
+	Iteration Methods
+*/
+//Rewind()
+template <typename TData, typename TKey, typename TKeyOf, int Shards, typename TList> void ShardedLinkedList<TData, TKey, TKeyOf, Shards, TList>::Rewind(){
+	for (int i = 0; i < Shards; i++){
+		_cursors[i] = _shards[i].List.GetFirstNode();
+	}
+	_PickCurrent();
+}
+//Next()
+template <typename TData, typename TKey, typename TKeyOf, int Shards, typename TList> ListNode<TData> *ShardedLinkedList<TData, TKey, TKeyOf, Shards, TList>::Next(){
+	if (_currentShard == Shards){
+		return NULL;
+	}
+	_cursors[_currentShard] = _cursors[_currentShard] -> Next();
+	_PickCurrent();
+	return Current();
+}
+//Current()
+template <typename TData, typename TKey, typename TKeyOf, int Shards, typename TList> ListNode<TData> *ShardedLinkedList<TData, TKey, TKeyOf, Shards, TList>::Current(){
+	return (_currentShard == Shards) ? NULL : _cursors[_currentShard];
+}
+
+/*
+	Modification Methods
+*/
+//InsertNewNodeOrdered()
+template <typename TData, typename TKey, typename TKeyOf, int Shards, typename TList> ListNode<TData> *ShardedLinkedList<TData, TKey, TKeyOf, Shards, TList>::InsertNewNodeOrdered(TData data){
+	Shard &shard = _shards[_ShardOf(data)];
+	std::lock_guard<SpinLock> lock(shard.Lock);
+	ListNode<TData> *node = shard.List.InsertNewNodeOrdered(std::move(data));
+	_Sequence(node) = _FrontSequence();		//At the head of an unordered list, and before the nodes with the same value otherwise
+	return node;
+}
+//PushBack()
+template <typename TData, typename TKey, typename TKeyOf, int Shards, typename TList> ListNode<TData> *ShardedLinkedList<TData, TKey, TKeyOf, Shards, TList>::PushBack(TData data){
+	if (_SortStatus != Unordered){		//Every shard has to agree, so that ordered inserts behave the same in all of them
+		_SetAllSortStatus(Unordered);
+	}
+	Shard &shard = _shards[_ShardOf(data)];
+	std::lock_guard<SpinLock> lock(shard.Lock);
+	ListNode<TData> *node = shard.List.PushBack(std::move(data));
+	_Sequence(node) = _BackSequence();
+	return node;
+}
+//DeleteNode()
+template <typename TData, typename TKey, typename TKeyOf, int Shards, typename TList> int ShardedLinkedList<TData, TKey, TKeyOf, Shards, TList>::DeleteNode(const TKey &key, int n){
+	Shard &shard = _shards[_ShardOf(key)];
+	std::lock_guard<SpinLock> lock(shard.Lock);
+	return shard.List.DeleteNode(key, n);
+}
+//Clear()
+template <typename TData, typename TKey, typename TKeyOf, int Shards, typename TList> void ShardedLinkedList<TData, TKey, TKeyOf, Shards, TList>::Clear(){
+	for (int i = 0; i < Shards; i++){
+		std::lock_guard<SpinLock> lock(_shards[i].Lock);
+		_shards[i].List.Clear();
+	}
+	_lowest = 0;
+	_highest = 0;
+	_reversed = false;
+	_SortStatus = Unordered;
+	Rewind();
+}
+
+/*
+	Batches
+*/
+//InsertOrderedBatch()
+//Each record is numbered as InsertNewNodeOrdered() would number it, before the batch is split by shard.
+template <typename TData, typename TKey, typename TKeyOf, int Shards, typename TList> template <typename TIterator> void ShardedLinkedList<TData, TKey, TKeyOf, Shards, TList>::InsertOrderedBatch(TIterator first, TIterator last){
+	std::vector<TData> batches[Shards];
+	std::vector<long long> sequences[Shards];
+	for (; first != last; ++first){
+		int shard = _ShardOf(*first);
+		batches[shard].push_back(*first);
+		sequences[shard].push_back(_FrontSequence());
+	}
+	_pool.Run(Shards, [&](int shard){
+		TList &list = _shards[shard].List;
+		std::lock_guard<SpinLock> lock(_shards[shard].Lock);
+		std::vector<ListNode<TData> *> nodes;
+		for (size_t i = 0; i < batches[shard].size(); i++){
+			nodes.push_back(list.CreateNode(std::move(batches[shard][i])));
+			_Sequence(nodes.back()) = sequences[shard][i];
+		}
+		list.InsertOrderedBatch(std::move(nodes));
+	});
+}
+//DeleteNodesBatch()
+template <typename TData, typename TKey, typename TKeyOf, int Shards, typename TList> int ShardedLinkedList<TData, TKey, TKeyOf, Shards, TList>::DeleteNodesBatch(const std::vector<TKey> &keys, const std::vector<int> &counts, std::vector<int> &deleted, TKeyOf keyOf){
+	std::vector<size_t> batches[Shards];		//Indexes of the keys in each shard, in the order they were given
+	for (size_t i = 0; i < keys.size(); i++){
+		batches[_ShardOf(keys[i])].push_back(i);
+	}
+	deleted.assign(keys.size(), 0);
+	_pool.Run(Shards, [&](int shard){
+		std::vector<TKey> shardKeys;
+		std::vector<int> shardCounts, shardDeleted;
+		for (size_t i = 0; i < batches[shard].size(); i++){
+			shardKeys.push_back(keys[batches[shard][i]]);
+			shardCounts.push_back(counts[batches[shard][i]]);
+		}
+		{
+			std::lock_guard<SpinLock> lock(_shards[shard].Lock);
+			_shards[shard].List.DeleteNodesBatch(shardKeys, shardCounts, shardDeleted, keyOf);
+		}
+		for (size_t i = 0; i < batches[shard].size(); i++){
+			deleted[batches[shard][i]] = shardDeleted[i];
+		}
+	});
+	int total = 0;
+	for (size_t i = 0; i < deleted.size(); i++){
+		total += deleted[i];
+	}
+	Rewind();
+	return total;
+}
+
+/*
+	Sort Related
+*/
+//Reverse()
+template <typename TData, typename TKey, typename TKeyOf, int Shards, typename TList> void ShardedLinkedList<TData, TKey, TKeyOf, Shards, TList>::Reverse(){
+	if (Length() < 2){		//Like LinkedList, a list of less than two nodes keeps its SortStatus
+		return;
+	}
+	SortOrder reversed = (_SortStatus == Ascending) ? Descending : ((_SortStatus == Descending) ? Ascending : Unordered);
+	//Shards with less than two nodes may not change their SortStatus, so it is set on every shard
+	_pool.Run(Shards, [&](int shard){
+		_shards[shard].List.Reverse();
+		_shards[shard].List.SetSortStatus(reversed);
+	});
+	_SortStatus = reversed;
+	_reversed = !_reversed;
+	Rewind();
+}
+//SetSortStatus()
+template <typename TData, typename TKey, typename TKeyOf, int Shards, typename TList> void ShardedLinkedList<TData, TKey, TKeyOf, Shards, TList>::SetSortStatus(SortOrder SortBy){
+	_SetAllSortStatus(SortBy);
+}
+//Sort()
+template <typename TData, typename TKey, typename TKeyOf, int Shards, typename TList> void ShardedLinkedList<TData, TKey, TKeyOf, Shards, TList>::Sort(SortOrder SortBy){
+	if (SortBy == Unordered || Length() < 2){
+		return;
+	}
+	_pool.Run(Shards, [&](int shard){
+		_shards[shard].List.Sort(SortBy);
+		_shards[shard].List.SetSortStatus(SortBy);		//Shards with less than two nodes may not have changed it
+	});
+	_SortStatus = SortBy;
+	Rewind();
+}
+//EnableIndex()
+template <typename TData, typename TKey, typename TKeyOf, int Shards, typename TList> void ShardedLinkedList<TData, TKey, TKeyOf, Shards, TList>::EnableIndex(bool enable){
+	for (int i = 0; i < Shards; i++){
+		_shards[i].List.EnableIndex(enable);
+	}
+}
+
+#endif /* ShardedLinkedList_H */
@@ -0,0 +1,247 @@
+/*
+	Yong Wen Chua
+	http://bit.ly/yongwen
+	Released under the LGPL license
+*/
+/*
+	SkipListIndex is a skip list over the nodes of an ordered LinkedList, keyed on the int() value of the node data.
+	It is used by LinkedList to find where to insert a node, to look up a node by its number, and to seek to a position,
+	in expected O(log n) time instead of walking the list.
+
+	Every node of the list has a tower in the index. A tower has a random number of levels, and each level links to the next
+	tower with at least as many levels, along with the number of nodes it skips (the width), so that positions can be found.
+	The index does not own the nodes. The list has to tell it about every node inserted and removed while it is built.
+*/
+//These Macros ensure that the file is only #included once.
+#pragma once
+#ifndef SkipListIndex_H
+#define SkipListIndex_H
+
+#include <new>
+#include <cstddef>
+#include "ListNode.h"
+
+template <typename TData=int> class SkipListIndex{
+	static const int MaxLevel = 16;		//Enough for 4^16 nodes
+
+	struct Tower;
+	struct Link{
+		Tower *Next;		//Next tower with at least as many levels
+		int Width;				//Number of nodes from this tower to Next. Only meaningful if Next is not NULL
+	};
+	struct Tower{
+		ListNode<TData> *Node;
+		int Key;
+		int Level;
+		Link Links[1];		//Actually Level links. Towers are allocated with as many links as they have levels
+	};
+
+	Tower *_head;			//Tower before the first node, with MaxLevel levels. NULL when the index is not built
+	int _level;				//Number of levels in use
+	bool _ascending;		//Order the index was built for
+	unsigned int _seed;		//State of the random number generator used to pick tower levels
+
+	//Indexes cannot be shared, so they cannot be copied.
+	SkipListIndex(const SkipListIndex &);
+	SkipListIndex &operator=(const SkipListIndex &);
+
+	//Returns true if key a comes before key b in the order of the index
+	bool _Before(int a, int b){
+		return _ascending ? (a < b) : (a > b);
+	}
+	//Picks a level for a new tower. Each extra level is taken with a probability of 1/4
+	int _RandomLevel(){
+		int level = 1;
+		_seed ^= _seed << 13;		//xorshift32
+		_seed ^= _seed >> 17;
+		_seed ^= _seed << 5;
+		unsigned int bits = _seed;
+		while (level < MaxLevel && (bits & 3) == 0){
+			level++;
+			bits >>= 2;
+		}
+		return level;
+	}
+	static Tower *_NewTower(ListNode<TData> *node, int key, int level){
+		Tower *tower = static_cast<Tower *>(::operator new(sizeof(Tower) + (level - 1) * sizeof(Link)));
+		tower -> Node = node;
+		tower -> Key = key;
+		tower -> Level = level;
+		for (int i = 0; i < level; i++){
+			tower -> Links[i].Next = NULL;
+			tower -> Links[i].Width = 0;
+		}
+		return tower;
+	}
+
+	public:
+		SkipListIndex(){
+			_head = NULL;
+			_level = 0;
+			_ascending = true;
+			_seed = 2463534242u;
+		}
+		~SkipListIndex(){
+			Clear();
+		}
+
+		bool IsBuilt(){ return (_head != NULL); }
+
+		//Drops the index
+		void Clear(){
+			Tower *tower, *next;
+			if (_head == NULL){
+				return;
+			}
+			tower = _head;
+			while (tower != NULL){
+				next = tower -> Links[0].Next;
+				::operator delete(tower);
+				tower = next;
+			}
+			_head = NULL;
+			_level = 0;
+		}
+
+		//Builds the index over the chain of nodes starting at first, which must be in ascending or descending order.
+		//Takes O(n) time.
+		void Build(ListNode<TData> *first, bool ascending){
+			Clear();
+			_ascending = ascending;
+			_head = _NewTower(NULL, 0, MaxLevel);
+			_level = 1;
+			Tower *last[MaxLevel];
+			int lastPosition[MaxLevel];
+			for (int i = 0; i < MaxLevel; i++){
+				last[i] = _head;
+				lastPosition[i] = 0;
+			}
+			int position = 0;
+			for (ListNode<TData> *node = first; node != NULL; node = node -> Next()){
+				position++;
+				int level = _RandomLevel();
+				Tower *tower = _NewTower(node, (int) node -> Data(), level);
+				for (int i = 0; i < level; i++){
+					last[i] -> Links[i].Next = tower;
+					last[i] -> Links[i].Width = position - lastPosition[i];
+					last[i] = tower;
+					lastPosition[i] = position;
+				}
+				if (level > _level){
+					_level = level;
+				}
+			}
+		}
+
+		//Adds node to the index, before any node with an equal key.
+		//Returns the node the new node has to be linked after in the list, or NULL if it goes to the head of the list.
+		ListNode<TData> *Insert(ListNode<TData> *node){
+			int key = (int) node -> Data();
+			Tower *update[MaxLevel];
+			int rank[MaxLevel];
+			Tower *tower = _head;
+			int position = 0;
+			for (int i = _level - 1; i >= 0; i--){
+				while (tower -> Links[i].Next != NULL && _Before(tower -> Links[i].Next -> Key, key)){
+					position += tower -> Links[i].Width;
+					tower = tower -> Links[i].Next;
+				}
+				update[i] = tower;
+				rank[i] = position;
+			}
+			int level = _RandomLevel();
+			if (level > _level){
+				for (int i = _level; i < level; i++){
+					update[i] = _head;
+					rank[i] = 0;
+				}
+				_level = level;
+			}
+			Tower *newTower = _NewTower(node, key, level);
+			for (int i = 0; i < level; i++){
+				newTower -> Links[i].Next = update[i] -> Links[i].Next;
+				newTower -> Links[i].Width = update[i] -> Links[i].Width - (position - rank[i]);
+				update[i] -> Links[i].Next = newTower;
+				update[i] -> Links[i].Width = position - rank[i] + 1;
+			}
+			for (int i = level; i < _level; i++){
+				update[i] -> Links[i].Width++;
+			}
+			return update[0] -> Node;
+		}
+
+		//Removes node from the index. The data of the node must not have changed since it was added.
+		void Remove(ListNode<TData> *node){
+			int key = (int) node -> Data();
+			Tower *update[MaxLevel];
+			for (int i = 0; i < MaxLevel; i++){
+				update[i] = _head;
+			}
+			Tower *tower = _head;
+			for (int i = _level - 1; i >= 0; i--){
+				while (tower -> Links[i].Next != NULL && _Before(tower -> Links[i].Next -> Key, key)){
+					tower = tower -> Links[i].Next;
+				}
+				update[i] = tower;
+			}
+			//There may be several towers with the same key. Walk past the ones that are not for node. Each of them may be
+			//taller than update[i] at some level, in which case it is the tower before node at that level instead.
+			Tower *target = update[0] -> Links[0].Next;
+			while (target != NULL && target -> Node != node){
+				for (int i = 0; i < target -> Level; i++){
+					update[i] = target;
+				}
+				target = target -> Links[0].Next;
+			}
+			if (target == NULL){
+				return;
+			}
+			for (int i = 0; i < _level; i++){
+				if (i < target -> Level){
+					update[i] -> Links[i].Width += target -> Links[i].Width - 1;
+					update[i] -> Links[i].Next = target -> Links[i].Next;
+				}
+				else{
+					update[i] -> Links[i].Width--;
+				}
+			}
+			::operator delete(target);
+			while (_level > 1 && _head -> Links[_level - 1].Next == NULL){
+				_level--;
+			}
+		}
+
+		//Returns the first node whose key equals key, or NULL if there is none
+		ListNode<TData> *Find(int key){
+			Tower *tower = _head;
+			for (int i = _level - 1; i >= 0; i--){
+				while (tower -> Links[i].Next != NULL && _Before(tower -> Links[i].Next -> Key, key)){
+					tower = tower -> Links[i].Next;
+				}
+			}
+			tower = tower -> Links[0].Next;
+			if (tower != NULL && tower -> Key == key){
+				return tower -> Node;
+			}
+			return NULL;
+		}
+
+		//Returns the node at position (counting from 0), or NULL if the list is not long enough
+		ListNode<TData> *Seek(int position){
+			Tower *tower = _head;
+			int travelled = 0;
+			position++;			//Position 0 is the head tower
+			for (int i = _level - 1; i >= 0; i--){
+				while (tower -> Links[i].Next != NULL && travelled + tower -> Links[i].Width <= position){
+					travelled += tower -> Links[i].Width;
+					tower = tower -> Links[i].Next;
+				}
+			}
+			if (travelled != position){
+				return NULL;
+			}
+			return tower -> Node;
+		}
+};
+
+#endif /* SkipListIndex_H */
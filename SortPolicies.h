@@ -0,0 +1,48 @@
+/*
+	Yong Wen Chua
+	http://bit.ly/yongwen
+	Released under the LGPL license
+*/
+/*
+	Ordering policies for LinkedList.
+
+	The order of an ordered list is given by two functors:
+		- TKeyOf returns the key of the data of a node, e.g. IntKeyOf, which returns its int() value, or ListNodeDataText.
+			Key operator()(const TData &Data) const
+		- TCompare returns true if key a goes strictly before key b in ascending order, e.g. KeyLess.
+			bool operator()(const Key &a, const Key &b) const
+
+	The direction of the order is not part of TCompare. SortDirection<Order> turns a comparison into one in Order order
+	at compile time, so that the comparisons made while sorting or inserting do not test the SortOrder each time.
+*/
+//These Macros ensure that the file is only #included once.
+#pragma once
+#ifndef SortPolicies_H
+#define SortPolicies_H
+
+enum SortOrder { Unordered, Ascending, Descending };		//Sort order enumeration
+
+//The int() value of the data. The default key of LinkedList
+template <typename TData> struct IntKeyOf{
+	int operator()(const TData &Data) const { return (int) Data; }
+};
+
+//Orders keys with their < operator. The default comparison of LinkedList
+struct KeyLess{
+	template <typename TKey> bool operator()(const TKey &a, const TKey &b) const { return a < b; }
+};
+
+//Before() returns true if key a goes strictly before key b in Order order, given a comparison in ascending order
+template <SortOrder Order> struct SortDirection;
+template <> struct SortDirection<Ascending>{
+	template <typename TCompare, typename TKey> static bool Before(const TCompare &Compare, const TKey &a, const TKey &b){
+		return Compare(a, b);
+	}
+};
+template <> struct SortDirection<Descending>{
+	template <typename TCompare, typename TKey> static bool Before(const TCompare &Compare, const TKey &a, const TKey &b){
+		return Compare(b, a);
+	}
+};
+
+#endif /* SortPolicies_H */
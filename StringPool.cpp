@@ -0,0 +1,47 @@
+/*
+	Yong Wen Chua
+	http://bit.ly/yongwen
+	Released under the LGPL license
+*/
+/*
+	StringPool interns strings. See StringPool.h
+*/
+#include "StringPool.h"
+#include <utility>
+using namespace std;
+
+const string *StringPool::Intern(const string &text){
+	return Intern(text.data(), text.size());
+}
+
+//The text is only copied into a string if it is not pooled yet
+const string *StringPool::Intern(const char *text, size_t length){
+	_Text key = { text, length };
+	lock_guard<mutex> lock(_mutex);
+	unordered_map<_Text, const string *, _Hash, _Equal>::iterator found = _lookup.find(key);
+	if (found != _lookup.end()){
+		return found -> second;
+	}
+	_strings.push_back(string(text, length));
+	const string *pooled = &_strings.back();
+	key.Data = pooled -> data();		//The pooled string never changes or moves, so neither do its characters
+	_lookup.insert(make_pair(key, pooled));
+	return pooled;
+}
+
+const string *StringPool::Find(const string &text){
+	_Text key = { text.data(), text.size() };
+	lock_guard<mutex> lock(_mutex);
+	unordered_map<_Text, const string *, _Hash, _Equal>::iterator found = _lookup.find(key);
+	return (found == _lookup.end()) ? NULL : found -> second;
+}
+
+size_t StringPool::Size(){
+	lock_guard<mutex> lock(_mutex);
+	return _strings.size();
+}
+
+StringPool &StringPool::Shared(){
+	static StringPool pool;		//Created the first time it is needed, so it exists before any data that uses it
+	return pool;
+}
@@ -0,0 +1,77 @@
+/*
+	Yong Wen Chua
+	http://bit.ly/yongwen
+	Released under the LGPL license
+*/
+/*
+	StringPool keeps one copy of every distinct string given to it (interning). Equal strings interned in the same pool
+	get the same pointer, so they can be compared by comparing pointers, and a text repeated over many nodes is stored once.
+
+	The strings are kept in a std::deque, which allocates them in large chunks and never moves them, so the pointers stay
+	valid for as long as the pool exists. Short strings keep their characters inside the string object itself, so most
+	names take no heap block of their own. Strings are never removed from the pool.
+
+	Texts are looked up by their characters, so interning a text that is already pooled, e.g. straight from a mapped data
+	file, makes no string and allocates nothing. Only a text that is new is copied into a string.
+
+	A pool can be used from several threads at once, e.g. by the shards of a ShardedLinkedList, which build their data on
+	the threads that call them. Intern() and Find() hold a lock. Pooled strings never change, so they can be read without it.
+*/
+//These Macros ensure that the file is only #included once.
+#pragma once
+#ifndef StringPool_H
+#define StringPool_H
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+
+class StringPool{
+	//Characters of a text, which need not be a string. The keys of _lookup point to the characters of the pooled strings
+	struct _Text{
+		const char *Data;
+		size_t Length;
+	};
+	//FNV-1a over the characters
+	struct _Hash{
+		size_t operator()(const _Text &text) const {
+			unsigned long long hash = 14695981039346656037ULL;
+			for (size_t i = 0; i < text.Length; i++){
+				hash = (hash ^ (unsigned char) text.Data[i]) * 1099511628211ULL;
+			}
+			return (size_t) hash;
+		}
+	};
+	struct _Equal{
+		bool operator()(const _Text &a, const _Text &b) const {
+			return a.Length == b.Length && memcmp(a.Data, b.Data, a.Length) == 0;
+		}
+	};
+
+	std::deque<std::string> _strings;
+	std::unordered_map<_Text, const std::string *, _Hash, _Equal> _lookup;
+	std::mutex _mutex;				//Guards _strings and _lookup
+
+	//Pointers handed out belong to the pool, so it cannot be copied.
+	StringPool(const StringPool &);
+	StringPool &operator=(const StringPool &);
+
+	public:
+		StringPool(){}
+
+		//Returns the pooled copy of text, adding it to the pool if it is not there yet
+		const std::string *Intern(const std::string &text);
+		const std::string *Intern(const char *text, size_t length);
+		//Returns the pooled copy of text, or NULL if it has never been interned
+		const std::string *Find(const std::string &text);
+
+		size_t Size();		//Number of distinct strings in the pool
+
+		//The pool shared by the whole program
+		static StringPool &Shared();
+};
+
+#endif /* StringPool_H */
@@ -0,0 +1,25 @@
+# Yong Wen Chua
+# http://bit.ly/yongwen
+# Released under the LGPL license
+#
+# Runs the programs EXPECTED and ACTUAL on the command file in TEST_DIR, each in its own copy of TEST_DIR under WORK_DIR,
+# and fails if they do not write the same output file.
+#   cmake -DEXPECTED=<program> -DACTUAL=<program> -DTEST_DIR=<dir> -DWORK_DIR=<dir> -P CompareOutputs.cmake
+file(GLOB inputs ${TEST_DIR}/CommandFile.txt ${TEST_DIR}/data_*.txt)
+foreach(program EXPECTED ACTUAL)
+	set(dir ${WORK_DIR}/${program})
+	file(REMOVE_RECURSE ${dir})
+	file(MAKE_DIRECTORY ${dir})
+	file(COPY ${inputs} DESTINATION ${dir})
+	file(WRITE ${dir}/input.txt "x\n")		#Answers the prompt at the end of the program
+	execute_process(COMMAND ${${program}} CommandFile.txt WORKING_DIRECTORY ${dir} INPUT_FILE ${dir}/input.txt
+		OUTPUT_FILE ${dir}/stdout.txt RESULT_VARIABLE result)
+	if(NOT result EQUAL 0)
+		message(FATAL_ERROR "${${program}} failed: ${result}")
+	endif()
+endforeach()
+execute_process(COMMAND ${CMAKE_COMMAND} -E compare_files ${WORK_DIR}/EXPECTED/output_1.txt ${WORK_DIR}/ACTUAL/output_1.txt
+	RESULT_VARIABLE different)
+if(different)
+	message(FATAL_ERROR "${ACTUAL} wrote a different output_1.txt from ${EXPECTED}. See ${WORK_DIR}")
+endif()
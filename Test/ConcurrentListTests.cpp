@@ -0,0 +1,75 @@
+/*
+	Yong Wen Chua
+	http://bit.ly/yongwen
+	Released under the LGPL license
+*/
+/*
+	ConcurrentListTests has many threads insert into, delete from and search a ConcurrentLinkedList at once.
+	It is built with ThreadSanitizer when the compiler supports it (see CMakeLists.txt), so that data races are reported too.
+	Each check that fails is reported with its line. The program returns the number of checks that failed.
+*/
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "ConcurrentLinkedList.h"
+using namespace std;
+
+static atomic<int> Failures(0);
+
+#define CHECK(condition) Check((condition), #condition, __LINE__)
+static void Check(bool passed, const char *condition, int line){
+	if (!passed){
+		cerr << "ConcurrentListTests.cpp:" << line << ": check failed: " << condition << endl;
+		Failures++;
+	}
+}
+
+static const int Threads = 4;
+static const int Rounds = 500;
+static const int HotKeys = 4;		//Keys every thread inserts and deletes, so that they race on the same nodes
+
+//Each thread inserts two nodes for each of its own keys and deletes one of them again, while it also inserts and deletes
+//nodes with the hot keys, which all threads share. A thread only deletes a hot key after inserting it, so there is always
+//a node for each delete to find.
+static void Work(ConcurrentLinkedList<int> *list, int thread){
+	for (int round = 0; round < Rounds; round++){
+		int own = HotKeys + round * Threads + thread, hot = round % HotKeys, found;
+		list -> InsertNewNodeOrdered(own);
+		list -> InsertNewNodeOrdered(hot);
+		list -> InsertNewNodeOrdered(own);
+		CHECK(list -> Contains(hot));
+		CHECK(list -> DeleteNode(hot));
+		CHECK(list -> DeleteNode(own));
+		CHECK(list -> Find(own, found) && found == own);
+	}
+}
+
+static void TestConcurrentList(){
+	ConcurrentLinkedList<int> list;
+	vector<thread> workers;
+	for (int t = 0; t < Threads; t++){
+		workers.push_back(thread(Work, &list, t));
+	}
+	for (size_t t = 0; t < workers.size(); t++){
+		workers[t].join();
+	}
+	CHECK(list.Length() == Threads * Rounds);
+	for (int key = 0; key < HotKeys; key++){
+		CHECK(!list.Contains(key));
+		CHECK(!list.DeleteNode(key));
+	}
+	for (int key = HotKeys; key < HotKeys + Threads * Rounds; key++){
+		CHECK(list.DeleteNode(key));
+		CHECK(!list.Contains(key));
+	}
+	CHECK(list.Length() == 0);
+}
+
+int main(){
+	TestConcurrentList();
+	if (Failures != 0){
+		cerr << Failures << " checks failed." << endl;
+	}
+	return Failures;
+}
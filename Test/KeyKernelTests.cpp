@@ -0,0 +1,118 @@
+/*
+	Yong Wen Chua
+	http://bit.ly/yongwen
+	Released under the LGPL license
+*/
+/*
+	KeyKernelTests checks every set of key kernels the CPU supports against plain loops, on the lengths around the
+	widths of the vectors (so that the keys left over by the vector versions are covered too), and on keys at the limits
+	of int. Sets the CPU does not support are skipped, and reported as such.
+	Each check that fails is reported with its line and the kernel set. The program returns the number of checks that failed.
+*/
+#include <climits>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "KeyKernels.h"
+using namespace std;
+
+static int Failures = 0;
+static const char *SetInUse = "";
+
+#define CHECK(condition) Check((condition), #condition, __LINE__)
+static void Check(bool passed, const char *condition, int line){
+	if (!passed){
+		cerr << "KeyKernelTests.cpp:" << line << ": check failed for the " << SetInUse << " kernels: " << condition << endl;
+		Failures++;
+	}
+}
+
+static unsigned int Seed = 12345;
+static int Random(int range){
+	Seed = Seed * 1103515245 + 12345;
+	return (int) ((Seed >> 8) % (unsigned int) range);
+}
+
+//The kernels on keys, against plain loops
+static void CheckKernels(const int *keys, size_t count){
+	long long sum = 0;
+	int min = (count == 0) ? 0 : keys[0], max = min;
+	for (size_t i = 0; i < count; i++){
+		sum += keys[i];
+		min = (keys[i] < min) ? keys[i] : min;
+		max = (keys[i] > max) ? keys[i] : max;
+	}
+	CHECK(KeySum(keys, count) == sum);
+	CHECK(KeyMin(keys, count) == min);
+	CHECK(KeyMax(keys, count) == max);
+
+	//Every key held, and keys that are not
+	vector<int> searches(keys, keys + count);
+	searches.push_back(INT_MIN);
+	searches.push_back(INT_MAX);
+	searches.push_back(0);
+	searches.push_back(-1);
+	for (size_t s = 0; s < searches.size(); s++){
+		size_t first = 0;
+		while (first < count && keys[first] != searches[s]){
+			first++;
+		}
+		CHECK(KeyFind(keys, count, searches[s]) == first);
+	}
+
+	const int ranges[][2] = { { INT_MIN, INT_MAX }, { INT_MIN, INT_MIN }, { INT_MAX, INT_MAX }, { 0, 0 }, { -5, 5 },
+		{ 5, -5 }, { INT_MIN, -1 }, { 1, INT_MAX }, { min, max }, { max, max } };
+	for (size_t r = 0; r < sizeof(ranges) / sizeof(ranges[0]); r++){
+		size_t inRange = 0;
+		for (size_t i = 0; i < count; i++){
+			inRange += (keys[i] >= ranges[r][0] && keys[i] <= ranges[r][1]) ? 1 : 0;
+		}
+		CHECK(KeyCountInRange(keys, count, ranges[r][0], ranges[r][1]) == inRange);
+	}
+}
+
+//Keys of count elements, by pattern
+static vector<int> MakeKeys(int pattern, size_t count){
+	vector<int> keys(count);
+	for (size_t i = 0; i < count; i++){
+		switch (pattern){
+			case 0: keys[i] = Random(2001) - 1000; break;					//Mixed signs
+			case 1: keys[i] = -1 - Random(1000000); break;					//All negative
+			case 2: keys[i] = Random(3) - 1; break;							//Few keys, many repeats
+			case 3: keys[i] = INT_MAX; break;								//Sums that overflow 32 bits
+			case 4: keys[i] = INT_MIN; break;
+			case 5: keys[i] = (i % 2 == 0) ? INT_MIN : INT_MAX; break;		//Limits in every lane
+			case 6: keys[i] = INT_MAX - Random(4); break;
+			default: keys[i] = (int) i; break;								//Increasing, so the last key is found last
+		}
+	}
+	return keys;
+}
+
+static void TestKernels(){
+	const size_t lengths[] = { 0, 1, 7, 8, 9, 33, 1000 };
+	for (int pattern = 0; pattern < 8; pattern++){
+		for (size_t l = 0; l < sizeof(lengths) / sizeof(lengths[0]); l++){
+			vector<int> keys = MakeKeys(pattern, lengths[l] + 1);
+			CheckKernels(keys.data(), lengths[l]);
+			CheckKernels(keys.data() + 1, lengths[l]);		//Not aligned to the width of the vectors
+		}
+	}
+}
+
+int main(){
+	const KeyKernelSet sets[] = { PlainKernels, SSE41Kernels, AVX2Kernels };
+	const char *names[] = { "plain", "SSE4.1", "AVX2" };
+	for (int s = 0; s < 3; s++){
+		if (!UseKeyKernels(sets[s])){
+			cout << "The " << names[s] << " kernels are not supported by this CPU. Skipped." << endl;
+			continue;
+		}
+		SetInUse = names[s];
+		TestKernels();
+	}
+	if (Failures != 0){
+		cerr << Failures << " checks failed." << endl;
+	}
+	return Failures;
+}
@@ -0,0 +1,325 @@
+/*
+	Yong Wen Chua
+	http://bit.ly/yongwen
+	Released under the LGPL license
+*/
+/*
+	ListTests checks the containers against simple reference implementations.
+	Each check that fails is reported with its line. The program returns the number of checks that failed.
+*/
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+#include "List.h"
+#include "DoublyLinkedList.h"
+#include "ListNodeData.h"
+#include "StringPool.h"
+using namespace std;
+
+static int Failures = 0;
+
+#define CHECK(condition) Check((condition), #condition, __LINE__)
+static void Check(bool passed, const char *condition, int line){
+	if (!passed){
+		cerr << "ListTests.cpp:" << line << ": check failed: " << condition << endl;
+		Failures++;
+	}
+}
+
+static unsigned int Seed = 12345;
+static int Random(int range){
+	Seed = Seed * 1103515245 + 12345;
+	return (int) ((Seed >> 8) % (unsigned int) range);
+}
+
+//Compares SeekNumber() and SeekPosition() with a walk along the list
+template <typename TList> static void CheckSeeks(TList &list){
+	int position = 0;
+	for (auto node = list.GetFirstNode(); node != NULL; node = node -> Next(), position++){
+		CHECK(list.SeekPosition(position) == node);
+	}
+	CHECK(position == list.Length());
+	CHECK(list.SeekPosition(-1) == NULL);
+	CHECK(list.SeekPosition(position) == NULL);
+	for (int number = -1; number <= 201; number++){
+		auto first = list.GetFirstNode();
+		while (first != NULL && !(first -> Data() == number)){
+			first = first -> Next();
+		}
+		CHECK(list.SeekNumber(number) == first);
+	}
+}
+
+//SeekNumber() and SeekPosition() through the skip list index, as nodes are inserted and deleted in either order
+static void TestSeek(){
+	LinkedList<int> list;
+	list.EnableIndex();
+	for (int i = 0; i < 1000; i++){
+		list.PushBack(Random(200));
+	}
+	list.Sort(Ascending);
+	CheckSeeks(list);
+	for (int i = 0; i < 300; i++){
+		list.InsertNewNodeOrdered(Random(200));
+		list.DeleteNode(Random(200), 1);
+	}
+	CheckSeeks(list);
+	list.Reverse();
+	CheckSeeks(list);
+	for (int i = 0; i < 300; i++){
+		list.InsertNewNodeOrdered(Random(200));
+		list.DeleteNode(Random(200), 1);
+	}
+	CheckSeeks(list);
+	list.EnableIndex(false);
+	CheckSeeks(list);
+}
+
+//Deleting by text removes nodes that are not the first with their number, from behind taller towers with the same number
+static void TestSeekDuplicates(){
+	LinkedList<ListNodeData> list;
+	list.EnableIndex();
+	for (int i = 0; i < 200; i++){
+		list.PushBack(ListNodeData(Random(5), "name" + to_string(i)));
+	}
+	list.Sort(Ascending);
+	CheckSeeks(list);
+	for (int i = 0; i < 150; i++){
+		list.DeleteNode("name" + to_string(Random(200)), 1);
+		CheckSeeks(list);
+		if (i % 10 == 0){
+			list.InsertNewNodeOrdered(ListNodeData(Random(5), "new" + to_string(i)));
+			CheckSeeks(list);
+		}
+	}
+}
+
+//Threads interning the same texts at once all get the same pointer for each text
+static void TestStringPoolThreads(){
+	StringPool pool;
+	const int threads = 8, texts = 2000;
+	vector<vector<const string *> > pooled(threads, vector<const string *>(texts));
+	vector<thread> workers;
+	for (int t = 0; t < threads; t++){
+		workers.push_back(thread([&pool, &pooled, t]{
+			for (int i = 0; i < texts; i++){
+				int text = (i * 7 + t * 131) % texts;		//Each thread goes through the texts in a different order
+				pooled[t][text] = pool.Intern("text" + to_string(text));
+			}
+		}));
+	}
+	for (size_t t = 0; t < workers.size(); t++){
+		workers[t].join();
+	}
+	CHECK(pool.Size() == (size_t) texts);
+	for (int i = 0; i < texts; i++){
+		CHECK(*pooled[0][i] == "text" + to_string(i));
+		for (int t = 1; t < threads; t++){
+			CHECK(pooled[t][i] == pooled[0][i]);
+		}
+	}
+}
+
+//InsertOrderedBatch() copies the records, unless it is given std::move_iterators
+template <typename TList> static void CheckBatchCopies(){
+	vector<ListNodeData> records;
+	for (int i = 0; i < 50; i++){
+		records.push_back(ListNodeData(Random(10), "record" + to_string(i)));
+	}
+	TList copied, moved;
+	copied.Sort(Ascending);
+	copied.InsertOrderedBatch(records.begin(), records.end());
+	for (int i = 0; i < 50; i++){
+		CHECK(records[i].Text() == "record" + to_string(i));
+	}
+	moved.Sort(Ascending);
+	moved.InsertOrderedBatch(make_move_iterator(records.begin()), make_move_iterator(records.end()));
+	CHECK(copied.Length() == 50 && moved.Length() == 50);
+	auto a = copied.GetFirstNode();
+	auto b = moved.GetFirstNode();
+	for (; a != NULL && b != NULL; a = a -> Next(), b = b -> Next()){
+		CHECK(a -> Data().Number() == b -> Data().Number() && a -> Data().Text() == b -> Data().Text());
+	}
+}
+static void TestBatchCopies(){
+	CheckBatchCopies<LinkedList<ListNodeData> >();
+	CheckBatchCopies<DoublyLinkedList<ListNodeData> >();
+}
+
+//The records of a list in list order, and of a vector, each as its number and its text
+template <typename TList> static vector<string> Contents(TList &list){
+	vector<string> contents;
+	for (list.Rewind(); list.Current() != NULL; list.Next()){
+		contents.push_back(to_string(list.Current() -> Data().Number()) + " " + list.Current() -> Data().Text());
+	}
+	return contents;
+}
+static vector<string> Describe(const vector<ListNodeData> &records){
+	vector<string> contents;
+	for (size_t i = 0; i < records.size(); i++){
+		contents.push_back(to_string(records[i].Number()) + " " + records[i].Text());
+	}
+	return contents;
+}
+
+//size records with numbers below keys, so that many share a number. Each has its own text, so that their order shows
+static vector<ListNodeData> MakeRecords(const string &name, int size, int keys){
+	vector<ListNodeData> records;
+	for (int i = 0; i < size; i++){
+		records.push_back(ListNodeData(Random(keys), name + to_string(i)));
+	}
+	return records;
+}
+
+//Sort() orders the records as std::stable_sort() does, from any order, in either direction
+template <typename TList> static void CheckSort(TList &list, int size){
+	vector<ListNodeData> expected = MakeRecords("record", size, size / 8 + 1);
+	for (size_t i = 0; i < expected.size(); i++){
+		list.PushBack(expected[i]);
+	}
+	list.Sort(Ascending);
+	stable_sort(expected.begin(), expected.end(), [](const ListNodeData &a, const ListNodeData &b){ return a.Number() < b.Number(); });
+	CHECK(Contents(list) == Describe(expected));
+	CHECK(size < 2 || list.GetSortStatus() == Ascending);		//Shorter lists are left as they are
+	list.Sort(Descending);
+	stable_sort(expected.begin(), expected.end(), [](const ListNodeData &a, const ListNodeData &b){ return a.Number() > b.Number(); });
+	CHECK(Contents(list) == Describe(expected));
+	CHECK(size < 2 || list.GetSortStatus() == Descending);
+}
+static void TestSort(){
+	const int sizes[] = { 0, 1, 2, 100, 300, 5000 };		//300 and 5000 are radix sorted by LinkedList
+	for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++){
+		LinkedList<ListNodeData> list;
+		CheckSort(list, sizes[i]);
+		DoublyLinkedList<ListNodeData> doubly;
+		CheckSort(doubly, sizes[i]);
+	}
+	LinkedList<ListNodeData> parallel;
+	parallel.SetSortThreads(4, 1000);
+	CheckSort(parallel, 20000);
+}
+
+//InsertOrderedBatch() leaves the list as InsertNewNodeOrdered() called for each record in turn does
+template <typename TList> static void CheckBatchInsert(TList &one, TList &batched, SortOrder order, int size, int batchSize){
+	vector<ListNodeData> existing = MakeRecords("old", size, 20), batch = MakeRecords("new", batchSize, 20);
+	for (size_t i = 0; i < existing.size(); i++){
+		one.PushBack(existing[i]);
+		batched.PushBack(existing[i]);
+	}
+	if (order != Unordered){
+		one.Sort(order);
+		batched.Sort(order);
+	}
+	for (size_t i = 0; i < batch.size(); i++){
+		one.InsertNewNodeOrdered(batch[i]);
+	}
+	batched.InsertOrderedBatch(batch.begin(), batch.end());
+	CHECK(Contents(one) == Contents(batched));
+	CHECK(one.Length() == batched.Length());
+}
+static void TestBatchInsert(){
+	const SortOrder orders[] = { Ascending, Descending, Unordered };
+	const int sizes[][2] = { { 0, 10 }, { 100, 10 }, { 100, 300 }, { 1000, 20 } };
+	for (size_t o = 0; o < 3; o++){
+		for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++){
+			LinkedList<ListNodeData> one, batched;
+			CheckBatchInsert(one, batched, orders[o], sizes[i][0], sizes[i][1]);
+			LinkedList<ListNodeData> indexedOne, indexedBatched;		//Small batches go through the skip list index
+			indexedOne.EnableIndex();
+			indexedBatched.EnableIndex();
+			CheckBatchInsert(indexedOne, indexedBatched, orders[o], sizes[i][0], sizes[i][1]);
+			DoublyLinkedList<ListNodeData> doublyOne, doublyBatched;
+			CheckBatchInsert(doublyOne, doublyBatched, orders[o], sizes[i][0], sizes[i][1]);
+		}
+	}
+}
+
+//DeleteNodesBatch() deletes the same nodes as DeleteNode() called for each key in turn. Texts are shared by many records,
+//keys repeat and some match no record, and the counts are -1 (all), 0, 1 or 2
+template <typename TList, typename TKey, typename TKeyOf> static void CheckBatchDelete(TKeyOf keyOf, TKey (*makeKey)(const string &)){
+	TList one, batched;
+	for (int i = 0; i < 500; i++){
+		ListNodeData record(Random(50), "text" + to_string(Random(40)));
+		one.PushBack(record);
+		batched.PushBack(record);
+	}
+	vector<string> texts;		//Without USE_STRING_POOL, a ListNodeDataKey points to the text it was made from
+	vector<TKey> keys;
+	vector<int> counts, deletedOne, deletedBatched;
+	for (int i = 0; i < 60; i++){
+		texts.push_back("text" + to_string(Random(50)));
+		counts.push_back(Random(4) - 1);
+	}
+	for (size_t i = 0; i < texts.size(); i++){
+		keys.push_back(makeKey(texts[i]));
+	}
+	for (size_t i = 0; i < keys.size(); i++){
+		deletedOne.push_back(one.DeleteNode(keys[i], counts[i]));
+	}
+	int total = batched.DeleteNodesBatch(keys, counts, deletedBatched, keyOf);
+	CHECK(deletedOne == deletedBatched);
+	CHECK(total == 500 - batched.Length());
+	CHECK(Contents(one) == Contents(batched));
+}
+static string TextOf(const string &text){
+	return text;
+}
+static void TestBatchDelete(){
+	CheckBatchDelete<LinkedList<ListNodeData>, string>(ListNodeDataText(), TextOf);
+	CheckBatchDelete<LinkedList<ListNodeData>, ListNodeDataKey>(ListNodeDataTextKey(), ListNodeData::Key);
+	CheckBatchDelete<LinkedList<ListNodeData, SlabNodeAllocator<ListNode<ListNodeData> >, HashIndex<ListNodeData, string, ListNodeDataText> >,
+		string>(ListNodeDataText(), TextOf);
+	CheckBatchDelete<LinkedList<ListNodeData, SlabNodeAllocator<ListNode<ListNodeData> >, HashIndex<ListNodeData, ListNodeDataKey, ListNodeDataTextKey> >,
+		ListNodeDataKey>(ListNodeDataTextKey(), ListNodeData::Key);
+	CheckBatchDelete<DoublyLinkedList<ListNodeData>, string>(ListNodeDataText(), TextOf);
+	CheckBatchDelete<DoublyLinkedList<ListNodeData, SlabNodeAllocator<DoublyListNode<ListNodeData> >, HashIndex<ListNodeData, ListNodeDataKey, ListNodeDataTextKey> >,
+		ListNodeDataKey>(ListNodeDataTextKey(), ListNodeData::Key);
+	CheckBatchDelete<UnrolledLinkedList<ListNodeData, 16>, string>(ListNodeDataText(), TextOf);
+}
+
+//Clear() leaves a list that is used as a new one
+template <typename TList> static void CheckClear(TList &list){
+	vector<ListNodeData> records = MakeRecords("record", 100, 10);
+	for (size_t i = 0; i < records.size(); i++){
+		list.PushBack(records[i]);
+	}
+	list.Sort(Ascending);
+	list.Clear();
+	CHECK(list.Length() == 0 && list.GetSortStatus() == Unordered && Contents(list).empty());
+	CHECK(list.DeleteNode(records[0].Text()) == 0);
+	long long sum = 0;
+	for (size_t i = 0; i < records.size(); i++){
+		list.PushBack(records[i]);
+		sum += records[i].Number();
+	}
+	CHECK(Contents(list) == Describe(records));
+	CHECK(list.Sum() == sum);
+	CHECK(list.DeleteNode(records[0].Text()) == 1);
+}
+static void TestClear(){
+	LinkedList<ListNodeData, SlabNodeAllocator<ListNode<ListNodeData> >, HashIndex<ListNodeData, string, ListNodeDataText>, ListAggregates<ListNodeData> > list;
+	CheckClear(list);
+	DoublyLinkedList<ListNodeData, SlabNodeAllocator<DoublyListNode<ListNodeData> >, HashIndex<ListNodeData, string, ListNodeDataText>, ListAggregates<ListNodeData> > doubly;
+	CheckClear(doubly);
+	UnrolledLinkedList<ListNodeData, 16> unrolled;
+	CheckClear(unrolled);
+}
+
+int main(){
+	TestSeek();
+	TestSeekDuplicates();
+	TestStringPoolThreads();
+	TestBatchCopies();
+	TestSort();
+	TestBatchInsert();
+	TestBatchDelete();
+	TestClear();
+	if (Failures != 0){
+		cerr << Failures << " checks failed." << endl;
+	}
+	return Failures;
+}
@@ -0,0 +1,87 @@
+/*
+	Yong Wen Chua
+	http://bit.ly/yongwen
+	Released under the LGPL license
+*/
+/*
+	ThreadPool runs numbered tasks on a fixed set of threads. See ThreadPool.h
+*/
+#include "ThreadPool.h"
+using namespace std;
+
+ThreadPool::ThreadPool(int threads){
+	_task = NULL;
+	_count = 0;
+	_next = 0;
+	_running = 0;
+	_generation = 0;
+	_stop = false;
+	if (threads <= 0){
+		threads = (int) thread::hardware_concurrency();		//0 if it cannot be told
+	}
+	for (int i = 1; i < threads; i++){			//The thread calling Run() is one of them
+		_workers.push_back(thread(&ThreadPool::_Work, this));
+	}
+}
+
+ThreadPool::~ThreadPool(){
+	{
+		lock_guard<mutex> lock(_mutex);
+		_stop = true;
+	}
+	_wake.notify_all();
+	for (size_t i = 0; i < _workers.size(); i++){
+		_workers[i].join();
+	}
+}
+
+void ThreadPool::_RunTasks(){
+	int task;
+	while ((task = _next++) < _count){
+		(*_task)(task);
+	}
+}
+
+void ThreadPool::_Work(){
+	unsigned int seen = 0;
+	unique_lock<mutex> lock(_mutex);
+	while (true){
+		while (!_stop && _generation == seen){
+			_wake.wait(lock);
+		}
+		if (_stop){
+			return;
+		}
+		seen = _generation;
+		lock.unlock();
+		_RunTasks();
+		lock.lock();
+		if (--_running == 0){
+			_done.notify_one();
+		}
+	}
+}
+
+void ThreadPool::Run(int count, const function<void(int)> &task){
+	lock_guard<mutex> turn(_runMutex);
+	if (_workers.empty() || count == 1){		//Nothing to gain from waking the workers
+		for (int i = 0; i < count; i++){
+			task(i);
+		}
+		return;
+	}
+	{
+		lock_guard<mutex> lock(_mutex);
+		_task = &task;
+		_count = count;
+		_next = 0;
+		_running = (int) _workers.size();
+		_generation++;
+	}
+	_wake.notify_all();
+	_RunTasks();
+	unique_lock<mutex> lock(_mutex);
+	while (_running > 0){
+		_done.wait(lock);
+	}
+}
@@ -0,0 +1,71 @@
+/*
+	Yong Wen Chua
+	http://bit.ly/yongwen
+	Released under the LGPL license
+*/
+/*
+	ThreadPool keeps a fixed set of worker threads to run numbered tasks in parallel.
+	Run(count, task) calls task(0) to task(count - 1), spread over the workers and the calling thread, and returns once
+	all of them are done. The threads wait for the next call to Run() in between, so no thread is created per call.
+
+	SpinLock is a lock for very short critical sections, which spins instead of sleeping while it waits.
+*/
+//These Macros ensure that the file is only #included once.
+#pragma once
+#ifndef ThreadPool_H
+#define ThreadPool_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+
+class ThreadPool{
+	std::vector<std::thread> _workers;
+	std::mutex _mutex;						//Guards everything below, except _next
+	std::condition_variable _wake;			//Signalled when there are tasks to run, or when the pool is stopping
+	std::condition_variable _done;			//Signalled when the last worker is done with the tasks
+	const std::function<void(int)> *_task;
+	int _count;								//Number of tasks in the current call to Run()
+	std::atomic<int> _next;					//Next task to hand out
+	int _running;							//Number of workers still working on the current call
+	unsigned int _generation;				//Counts calls to Run(), so that workers can tell a new call from a spurious wake up
+	bool _stop;
+	std::mutex _runMutex;					//Calls to Run() from different threads take turns
+
+	void _Work();			//Body of a worker thread
+	void _RunTasks();		//Takes and runs tasks until there are none left
+
+	//Threads cannot be shared, so the pool cannot be copied.
+	ThreadPool(const ThreadPool &);
+	ThreadPool &operator=(const ThreadPool &);
+
+	public:
+		//Uses threads threads in all, counting the thread that calls Run(). 0 uses one per hardware thread.
+		ThreadPool(int threads = 0);
+		~ThreadPool();
+
+		int Threads(){ return (int) _workers.size() + 1; }		//Number of threads tasks are run on, counting the caller
+
+		void Run(int count, const std::function<void(int)> &task);
+};
+
+class SpinLock{
+	std::atomic_flag _flag;
+
+	SpinLock(const SpinLock &);
+	SpinLock &operator=(const SpinLock &);
+
+	public:
+		SpinLock(){ _flag.clear(); }
+		void lock(){
+			while (_flag.test_and_set(std::memory_order_acquire)){
+				std::this_thread::yield();
+			}
+		}
+		void unlock(){ _flag.clear(std::memory_order_release); }
+};
+
+#endif /* ThreadPool_H */
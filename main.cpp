@@ -18,14 +18,16 @@
 #include "Operation.h"
 #include "List.h"
 #include "ListNodeData.h"		//List Node Data is "custom"
+#include "OutputWriter.h"
 
 using namespace std;
 
 //Global Variables
-LinkedList<ListNodeData>  TheList;			//The Linked List
-ifstream CommandFile, DataFile;				//Input File Streams
-ofstream OutputFile;						//Output file streams
+DataList  TheList;							//The Linked List. DataList is defined in Operation.h
+ifstream CommandFile;						//Input File Stream
+OutputWriter OutputFile;					//Buffered output file
 string FileNumber;							//File Number for input and output
+CommandTimes Latencies;						//Time taken by each command. Only kept with USE_INSTRUMENTATION. See Operation.h
 
 int main(int argc, char* argv[]){
 	if (argc < 2){			//Missing argument
@@ -37,6 +39,9 @@ int main(int argc, char* argv[]){
 	if (!CommandFile){
 		TerminateError("Unable to open command file.");
 	}
+	#if !defined(USE_UNROLLED_LIST) && !defined(USE_DOUBLY_LINKED_LIST) && !defined(USE_COLUMNAR_LIST)
+		TheList.EnableIndex();		//Ordered inserts use the skip list index once the list is sorted
+	#endif
 	cout << "Parsing and executing command file..." << endl;
 	string line, text, search;
 	int number;
@@ -44,40 +49,64 @@ int main(int argc, char* argv[]){
 		//Using Getline instead of the extraction operator takes care of the newline character
 		//cf same problem with sscanf()
 		GetLine(CommandFile, line);			
+		//A run of inserts or deletes is timed as one command, when it is flushed
+		Latencies.Start();
+		if (line != "i" && line != "I" && FlushInserts()){		//A run of inserts has ended. Insert them as one batch before going on
+			Latencies.Stop('i');
+		}
+		Latencies.Start();
+		if (line != "d" && line != "D" && FlushDeletes()){		//Likewise for deletes
+			Latencies.Stop('d');
+		}
+		Latencies.Start();
 		//Parse for commands
 		if (line == "r" || line == "R"){		//Read Command. Next command is file number
 			GetLine(CommandFile, FileNumber);		//GetLine gets rid of newline character.
 			ReadDataFile();
+			Latencies.Stop('r');
 		}
 		else if (line == "s" || line == "S"){	//Sort
 			cout << "Sorting List..." << endl;
 			TheList.Sort(Ascending);			//The SortOrder enum is defined in List.h
+			Latencies.Stop('s');
 		}
 		else if (line == "w" || line == "W"){	//Write file
 			DumpFile();
+			Latencies.Stop('w');
 		}
 		else if (line == "i" || line == "I"){	//Insert. Next two commands to be text and number
 			GetLine(CommandFile, text);		//GetLine gets rid of newline character.
 			CommandFile >> number;			//atoi() not used to prevent legacy problems. stringstream not used to prevent overhead
 			getline(CommandFile, line);		//Extract and discard the newline character to prevent unknown command errors
-			TheList.InsertNewNodeOrdered(ListNodeData(number, text));		//Insert new node based on data
 			cout << "Inserting new node... " << text << " " << number << endl;
+			QueueInsert(number, text);			//Inserted along with the inserts right after it. See FlushInserts()
 		}
 		else if (line == "d" || line == "D"){	//Delete. Next command to be search parameter
 			GetLine(CommandFile, search);		//GetLine gets rid of newline character.
-			cout << "Deleting node " << search << "... ";
-			
-			cout << (TheList.DeleteNode(search,1) == 1 ? "Deleted." : "Not found.") << endl;
+			QueueDelete(search);			//Deleted along with the deletes right after it. See FlushDeletes()
 		}
 		else if (line == "x" || line == "X"){		//Reverse list
 			cout << "Reversing list..." << endl;
 			TheList.Reverse();
+			Latencies.Stop('x');
 		}
 		else if (line == "a" || line == "A"){		//Dump average value
 			DumpAverage();
+			Latencies.Stop('a');
 		}
 		else if (line == "m" || line == "M"){		//Dump max value
 			DumpMax();
+			Latencies.Stop('m');
+		}
+		else if (line == "b" || line == "B"){		//Write binary snapshot. Next command is file number
+			GetLine(CommandFile, FileNumber);
+			WriteSnapshot();
+			Latencies.Stop('b');
+		}
+		else if (line == "l" || line == "L"){		//Load binary snapshot. Next command is file number
+			GetLine(CommandFile, FileNumber);
+			ReadSnapshot();
+			Latencies.Stop('l');
 		}
 		else{										//Unknown command. Possibly non wellformed command file?
 			//EOL Format: Windows: \r\n Mac: \r Unix: \n
@@ -85,7 +114,20 @@ int main(int argc, char* argv[]){
 		}
 
 	}
-	OutputFile.close();
+	Latencies.Start();
+	if (FlushInserts()){
+		Latencies.Stop('i');
+	}
+	Latencies.Start();
+	if (FlushDeletes()){
+		Latencies.Stop('d');
+	}
+	OutputFile.Close();
+	#if defined(USE_INSTRUMENTATION)
+		cout << "-----------------" << endl;
+		OperationCounters::Dump(cout);
+		Latencies.Dump(cout);
+	#endif
 	cout << "-----------------" << endl << "Operation Complete. Type anything and enter to exit." << endl;
 	string dummy;				
 	cin >> dummy;				//A mechanism to allow the user to view the output, especially on Windows.
@@ -98,6 +140,7 @@ int main(int argc, char* argv[]){
 	General Functions
 */
 void TerminateError(string message){
+	OutputFile.Close();			//Do not lose what has been written so far
 	cout << "Error encountered: " << message << endl;
 	cout << "-----------------" << endl << "Type anything and enter to exit." << endl;
 	string dummy;				